@@ -0,0 +1,186 @@
+/*
+    SDPClassifier.h - Int8 neural network classification of SDP pressure windows.
+
+    Copyright (c) 2026 SDP3x-Arduino contributors
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef SDPCLASSIFIER_H
+#define SDPCLASSIFIER_H
+
+#include "Arduino.h"
+
+/*  One quantized dense layer
+
+    weights    - outputs x inputs int8 weights, one row per output
+    bias       - one bias per output, in units of the accumulator (input scale x weight scale)
+    multiplier - Q15 factor from the accumulator scale to the output scale, hidden layer only
+    shift      - extra right shift applied after the multiplier, hidden layer only
+*/
+typedef struct {
+    const int8_t *weights;
+    const int32_t *bias;
+    int16_t multiplier;
+    uint8_t shift;
+} SDPLayer;
+
+/*  The SDPClassifier class runs a small int8 MLP over fixed windows of raw pressure
+
+    The window mean is removed and the samples are shifted down to int8, so the model sees the
+    shape of the signal (eg. a slipping belt or an oscillating damper) rather than its level.
+    A hidden layer with ReLU feeds an output layer with one score per class. All math is integer,
+    nothing is allocated and the cost is Window x Hidden + Hidden x Classes multiply-adds.
+
+    Window  - samples per window
+    Hidden  - neurons in the hidden layer
+    Classes - number of classes, eg. normal plus one per fault
+*/
+template <uint16_t Window, uint8_t Hidden, uint8_t Classes>
+class SDPClassifier {
+    private:
+        /* The last Window samples, oldest at head once full */
+        int16_t samples[Window];
+        /* Model */
+        SDPLayer hidden;
+        SDPLayer output;
+        /* Right shift from raw counts to int8 inputs */
+        uint8_t inputShift;
+        /* Next slot to write */
+        uint16_t head;
+        /* Samples added since the last full window */
+        uint16_t fill;
+        /* true once Window samples were added */
+        bool full;
+
+        /*  Dot product of int8 vectors
+
+            @param a   - the first vector
+            @param b   - the second vector
+            @param len - the number of elements
+            @returns the sum of products
+        */
+        static int32_t dot(const int8_t *a, const int8_t *b, uint16_t len) {
+            int32_t acc = 0;
+            uint16_t i;
+            // Plain loop so the compiler can use the SIMD multiply-adds of the target
+            for (i = 0; i < len; i++) {
+                acc += (int16_t)a[i] * b[i];
+            }
+            return acc;
+        }
+
+        /*  Saturate to int8
+
+            @param v - the value
+            @returns v, clamped to -128 - 127
+        */
+        static int8_t saturate(int32_t v) {
+            return (int8_t)constrain(v, -128, 127);
+        }
+
+    public:
+        /*  Constructor
+
+            @param hidden     - the hidden layer, Hidden x Window weights
+            @param output     - the output layer, Classes x Hidden weights
+            @param inputShift - right shift from raw counts to int8 inputs, as used in training
+            @returns a new SDPClassifier with an empty window
+        */
+        SDPClassifier(const SDPLayer &hidden, const SDPLayer &output, const uint8_t inputShift) {
+            this->hidden     = hidden;
+            this->output     = output;
+            this->inputShift = inputShift;
+            reset();
+        }
+
+        /*  Add a sample
+
+            @param raw - the raw pressure value
+            @returns true, iff a new window of Window samples is complete
+        */
+        bool add(int16_t raw) {
+            this->samples[this->head] = raw;
+            this->head = (this->head + 1 < Window) ? this->head + 1 : 0;
+            if (++this->fill < Window) {
+                return false;
+            }
+            this->fill = 0;
+            this->full = true;
+            return true;
+        }
+
+        /*  Classify the last Window samples
+
+            @param scores - if not null, a buffer of Classes values to store the raw class scores
+            @returns the class with the highest score, -1 iff the window is not full yet
+        */
+        int8_t classify(int32_t *scores = NULL) {
+            int8_t  input[Window];
+            int8_t  activation[Hidden];
+            int32_t sum = 0, best = 0, score;
+            int8_t  result = 0;
+            int16_t mean;
+            uint16_t i, at;
+            if (!this->full) {
+                return -1;
+            }
+            for (i = 0; i < Window; i++) {
+                sum += this->samples[i];
+            }
+            mean = (int16_t)(sum / (int32_t)Window);
+            // Oldest sample first, as in training
+            at = this->head;
+            for (i = 0; i < Window; i++) {
+                input[i] = saturate((this->samples[at] - mean) >> this->inputShift);
+                at = (at + 1 < Window) ? at + 1 : 0;
+            }
+            for (i = 0; i < Hidden; i++) {
+                int32_t acc = dot(this->hidden.weights + (uint32_t)i * Window, input, Window) +
+                              this->hidden.bias[i];
+                // ReLU, then requantize to int8
+                acc = (acc > 0) ? (int32_t)(((int64_t)acc * this->hidden.multiplier) >>
+                                            (15 + this->hidden.shift))
+                                : 0;
+                activation[i] = saturate(acc);
+            }
+            for (i = 0; i < Classes; i++) {
+                score = dot(this->output.weights + (uint16_t)i * Hidden, activation, Hidden) +
+                        this->output.bias[i];
+                if (scores != NULL) {
+                    scores[i] = score;
+                }
+                if ((i == 0) || (score > best)) {
+                    best   = score;
+                    result = (int8_t)i;
+                }
+            }
+            return result;
+        }
+
+        /* Clear the window, eg. after the sensor was restarted */
+        void reset() {
+            uint16_t i;
+            for (i = 0; i < Window; i++) {
+                this->samples[i] = 0;
+            }
+            this->head = 0;
+            this->fill = 0;
+            this->full = false;
+        }
+};
+
+#endif
@@ -0,0 +1,139 @@
+/*
+    SDPClockSync.cpp - Conversion of board micros() timestamps to gateway time.
+
+    Copyright (c) 2026 SDP3x-Arduino contributors
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SDPClockSync.h"
+
+/*  Constructor
+
+    @returns a new SDPClockSync, not synced yet
+*/
+SDPClockSync::SDPClockSync() {
+    this->reset();
+}
+
+/*  Feed the result of one sync exchange
+
+    @param sent           - local micros() when the request was sent
+    @param remoteReceived - gateway time when the request arrived, in microseconds
+    @param remoteSent     - gateway time when the reply was sent, in microseconds
+    @param received       - local micros() when the reply arrived
+    @returns true, iff the exchange was used
+*/
+bool SDPClockSync::update(uint32_t sent, uint64_t remoteReceived, uint64_t remoteSent,
+                          uint32_t received) {
+    uint32_t local      = received - sent;
+    uint64_t processing = remoteSent - remoteReceived;
+    uint32_t roundTrip  = (processing < local) ? local - (uint32_t)processing : 0;
+    // Both clocks at the midpoint of the round trip, assuming equal delays both ways
+    uint32_t mid    = sent + local / 2;
+    int64_t  remote = (int64_t)(remoteReceived + processing / 2);
+    int64_t  predicted, measured;
+    uint32_t span;
+
+    // Too long since the last exchange to tell how often micros() wrapped: start over
+    if ((this->exchanges == 0) || ((uint32_t)(mid - this->anchorLocal) > 0x60000000UL)) {
+        this->anchorLocal  = mid;
+        this->anchorRemote = remote;
+        this->refLocal     = mid;
+        this->refRemote    = remote;
+        this->minRoundTrip = roundTrip;
+        this->exchanges    = 1;
+        return true;
+    }
+
+    // Queued or retried exchanges carry mostly delay, not offset. The best round trip is let
+    // to age so a route that got slower for good is not locked out.
+    if (roundTrip < this->minRoundTrip) {
+        this->minRoundTrip = roundTrip;
+    } else {
+        this->minRoundTrip += (this->minRoundTrip >> 4) + 1;
+        if (roundTrip > 2 * this->minRoundTrip + 50) {
+            return false;
+        }
+    }
+
+    // Move the anchor a quarter of the way to the measurement, to filter jitter
+    predicted          = (int64_t)this->toRemote(mid);
+    this->anchorLocal  = mid;
+    this->anchorRemote = predicted + (remote - predicted) / 4;
+
+    span = mid - this->refLocal;
+    if (span >= SDP_SYNC_SKEW_SPAN) {
+        measured = ((remote - this->refRemote) - (int64_t)span) * 4294967296LL / (int64_t)span;
+        measured = constrain(measured, -2147483647LL, 2147483647LL);
+        if (this->measurements == 0) {
+            this->skew = (int32_t)measured;
+        } else {
+            this->skew += (int32_t)((measured - this->skew) / 4);
+        }
+        if (this->measurements < 255) {
+            this->measurements++;
+        }
+        this->refLocal  = mid;
+        this->refRemote = remote;
+    }
+    if (this->exchanges < 255) {
+        this->exchanges++;
+    }
+    return true;
+}
+
+/*  Check whether times can be converted yet
+
+    @returns true, iff at least one exchange was accepted
+*/
+bool SDPClockSync::synced() {
+    return this->exchanges != 0;
+}
+
+/*  Convert a local timestamp to gateway time
+
+    @param local - a micros() value, within about 35 minutes of the last exchange
+    @returns the gateway time in microseconds, 0 iff not synced
+*/
+uint64_t SDPClockSync::toRemote(uint32_t local) {
+    int64_t elapsed;
+    if (this->exchanges == 0) {
+        return 0;
+    }
+    elapsed = (int32_t)(local - this->anchorLocal);
+    return (uint64_t)(this->anchorRemote + elapsed + ((elapsed * this->skew) >> 32));
+}
+
+/*  Get the estimated clock skew
+
+    @returns how much faster the gateway clock runs, in parts per billion
+*/
+int32_t SDPClockSync::getDrift() {
+    return (int32_t)(((int64_t)this->skew * 1000000000LL) >> 32);
+}
+
+/* Forget all exchanges, eg. after the gateway clock was stepped */
+void SDPClockSync::reset() {
+    this->anchorLocal  = 0;
+    this->anchorRemote = 0;
+    this->refLocal     = 0;
+    this->refRemote    = 0;
+    this->skew         = 0;
+    this->minRoundTrip = 0;
+    this->exchanges    = 0;
+    this->measurements = 0;
+}
@@ -0,0 +1,103 @@
+/*
+    SDPClockSync.h - Conversion of board micros() timestamps to gateway time.
+
+    Copyright (c) 2026 SDP3x-Arduino contributors
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef SDPCLOCKSYNC_H
+#define SDPCLOCKSYNC_H
+
+#include "Arduino.h"
+
+/*  Time between two skew measurements, in local microseconds
+
+    Longer spans average out more round trip jitter. Keep it well below the 71 minutes it takes
+    micros() to wrap.
+*/
+#ifndef SDP_SYNC_SKEW_SPAN
+#define SDP_SYNC_SKEW_SPAN 60000000UL
+#endif
+
+/*  The SDPClockSync class maps this board's micros() to the gateway clock
+
+    Each sync exchange is NTP-style: the board notes micros() when it sends a request and when the
+    reply arrives, and the gateway replies with its own receive and send times. The offset is
+    measured at the midpoint of the round trip, exchanges delayed by more than twice the best
+    recent round trip are dropped, and the clock skew is estimated over SDP_SYNC_SKEW_SPAN.
+
+    All math is integer, with the skew in parts per 2^32. Sample times only need to be within
+    about 35 minutes of the last accepted exchange, so wrapping of micros() does not matter.
+*/
+class SDPClockSync {
+    private:
+        /* Local and gateway time of the conversion anchor */
+        uint32_t anchorLocal;
+        int64_t anchorRemote;
+        /* Raw measurement the next skew measurement is taken against */
+        uint32_t refLocal;
+        int64_t refRemote;
+        /* Local clock skew, parts per 2^32 */
+        int32_t skew;
+        /* Best recent round trip time */
+        uint32_t minRoundTrip;
+        /* Number of accepted exchanges and skew measurements so far, saturating */
+        uint8_t exchanges;
+        uint8_t measurements;
+
+    public:
+        /*  Constructor
+
+            @returns a new SDPClockSync, not synced yet
+        */
+        SDPClockSync();
+
+        /*  Feed the result of one sync exchange
+
+            @param sent           - local micros() when the request was sent
+            @param remoteReceived - gateway time when the request arrived, in microseconds
+            @param remoteSent     - gateway time when the reply was sent, in microseconds
+            @param received       - local micros() when the reply arrived
+            @returns true, iff the exchange was used
+        */
+        bool update(uint32_t sent, uint64_t remoteReceived, uint64_t remoteSent,
+                    uint32_t received);
+
+        /*  Check whether times can be converted yet
+
+            @returns true, iff at least one exchange was accepted
+        */
+        bool synced();
+
+        /*  Convert a local timestamp to gateway time
+
+            @param local - a micros() value, within about 35 minutes of the last exchange
+            @returns the gateway time in microseconds, 0 iff not synced
+        */
+        uint64_t toRemote(uint32_t local);
+
+        /*  Get the estimated clock skew
+
+            @returns how much faster the gateway clock runs, in parts per billion
+        */
+        int32_t getDrift();
+
+        /* Forget all exchanges, eg. after the gateway clock was stepped */
+        void reset();
+};
+
+#endif
@@ -0,0 +1,434 @@
+/*
+    SDPCodec.c - Plain C decoding of SDP sensor data, for boards and host tools alike.
+
+    Copyright (c) 2018 Bryan T. Meyers (CRC-8 table, moved from SDPSensors.h)
+    Copyright (c) 2026 SDP3x-Arduino contributors
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SDPCodec.h"
+
+/* Temperature Units - 1/C, see SDP3X_TempScale */
+#define SDP_TEMP_SCALE 200.0f
+
+/*  CRC-8 Lookup Table
+
+    Settings:
+    INIT           - 0xFF
+    POLY           - 0x31
+    Reflect Input  - No
+    Reflect Output - No
+    Final XOR      - 0x00
+
+    Source: http://www.sunshine2k.de/coding/javascript/crc/crc_js.html
+*/
+const uint8_t SDP_CRC_LUT[256] =
+    { 0x00, 0x31, 0x62, 0x53, 0xC4, 0xF5, 0xA6, 0x97, 0xB9, 0x88, 0xDB, 0xEA, 0x7D, 0x4C, 0x1F,
+    0x2E, 0x43, 0x72, 0x21, 0x10, 0x87, 0xB6, 0xE5, 0xD4, 0xFA, 0xCB, 0x98, 0xA9, 0x3E, 0x0F,
+    0x5C, 0x6D, 0x86, 0xB7, 0xE4, 0xD5, 0x42, 0x73, 0x20, 0x11, 0x3F, 0x0E, 0x5D, 0x6C, 0xFB,
+    0xCA, 0x99, 0xA8, 0xC5, 0xF4, 0xA7, 0x96, 0x01, 0x30, 0x63, 0x52, 0x7C, 0x4D, 0x1E, 0x2F,
+    0xB8, 0x89, 0xDA, 0xEB, 0x3D, 0x0C, 0x5F, 0x6E, 0xF9, 0xC8, 0x9B, 0xAA, 0x84, 0xB5, 0xE6,
+    0xD7, 0x40, 0x71, 0x22, 0x13, 0x7E, 0x4F, 0x1C, 0x2D, 0xBA, 0x8B, 0xD8, 0xE9, 0xC7, 0xF6,
+    0xA5, 0x94, 0x03, 0x32, 0x61, 0x50, 0xBB, 0x8A, 0xD9, 0xE8, 0x7F, 0x4E, 0x1D, 0x2C, 0x02,
+    0x33, 0x60, 0x51, 0xC6, 0xF7, 0xA4, 0x95, 0xF8, 0xC9, 0x9A, 0xAB, 0x3C, 0x0D, 0x5E, 0x6F,
+    0x41, 0x70, 0x23, 0x12, 0x85, 0xB4, 0xE7, 0xD6, 0x7A, 0x4B, 0x18, 0x29, 0xBE, 0x8F, 0xDC,
+    0xED, 0xC3, 0xF2, 0xA1, 0x90, 0x07, 0x36, 0x65, 0x54, 0x39, 0x08, 0x5B, 0x6A, 0xFD, 0xCC,
+    0x9F, 0xAE, 0x80, 0xB1, 0xE2, 0xD3, 0x44, 0x75, 0x26, 0x17, 0xFC, 0xCD, 0x9E, 0xAF, 0x38,
+    0x09, 0x5A, 0x6B, 0x45, 0x74, 0x27, 0x16, 0x81, 0xB0, 0xE3, 0xD2, 0xBF, 0x8E, 0xDD, 0xEC,
+    0x7B, 0x4A, 0x19, 0x28, 0x06, 0x37, 0x64, 0x55, 0xC2, 0xF3, 0xA0, 0x91, 0x47, 0x76, 0x25,
+    0x14, 0x83, 0xB2, 0xE1, 0xD0, 0xFE, 0xCF, 0x9C, 0xAD, 0x3A, 0x0B, 0x58, 0x69, 0x04, 0x35,
+    0x66, 0x57, 0xC0, 0xF1, 0xA2, 0x93, 0xBD, 0x8C, 0xDF, 0xEE, 0x79, 0x48, 0x1B, 0x2A, 0xC1,
+    0xF0, 0xA3, 0x92, 0x05, 0x34, 0x67, 0x56, 0x78, 0x49, 0x1A, 0x2B, 0xBC, 0x8D, 0xDE, 0xEF,
+    0x82, 0xB3, 0xE0, 0xD1, 0x46, 0x77, 0x24, 0x15, 0x3B, 0x0A, 0x59, 0x68, 0xFF, 0xCE, 0x9D,
+    0xAC };
+
+/*  Compute the CRC-8 of a sequence of bytes
+
+    @param data - the bytes to checksum
+    @param len  - the number of bytes in data
+    @returns the CRC-8 of data
+*/
+uint8_t sdp_crc8(const uint8_t *data, size_t len) {
+    uint8_t crc = 0xFF;
+    for (; len > 0; len--) {
+        crc = SDP_CRC_LUT[crc ^ *data++];
+    }
+    return crc;
+}
+
+/*  Check raw words as read from the sensor
+
+    @param raw   - words * 3 bytes read from the sensor
+    @param words - the number of words in raw
+    @returns the number of words whose CRC failed, 0 iff all passed
+*/
+size_t sdp_check_words(const uint8_t *raw, size_t words) {
+    size_t failed = 0;
+    for (; words > 0; words--) {
+        if (SDP_CRC_LUT[SDP_CRC_LUT[0xFF ^ raw[0]] ^ raw[1]] != raw[2]) {
+            failed++;
+        }
+        raw += 3;
+    }
+    return failed;
+}
+
+/*  Check and decode raw words as read from the sensor
+
+    @param raw   - words * 3 bytes read from the sensor
+    @param words - the number of words in raw
+    @param out   - a buffer of "words" values to store the decoded words
+    @returns the number of words whose CRC failed, 0 iff all passed
+*/
+size_t sdp_decode_words(const uint8_t *raw, size_t words, int16_t *out) {
+    size_t failed = sdp_check_words(raw, words);
+    for (; words > 0; words--) {
+        *out++ = (int16_t)(((uint16_t)raw[0] << 8) | raw[1]);
+        raw += 3;
+    }
+    return failed;
+}
+
+/*  Start a CRC for every lane
+
+    @param crc   - the 8 CRC planes to initialize
+    @param lanes - a mask of the lanes in use
+*/
+void sdp_crc8_sliced_init(uint32_t crc[8], uint32_t lanes) {
+    uint8_t bit;
+    // INIT 0xFF sets every bit of every lane
+    for (bit = 0; bit < 8; bit++) {
+        crc[bit] = lanes;
+    }
+}
+
+/*  Feed one byte of every lane
+
+    Each input bit costs one shift of the register and three XORs for POLY 0x31 (x^5 + x^4 + 1),
+    done for all lanes at once with plain bitwise operations.
+    @param crc    - the 8 CRC planes
+    @param planes - the 8 bit planes of the byte, MSB first
+*/
+void sdp_crc8_sliced_update(uint32_t crc[8], const uint32_t planes[8]) {
+    uint32_t feedback;
+    uint8_t i;
+    for (i = 0; i < 8; i++) {
+        feedback = crc[7] ^ planes[i];
+        crc[7]   = crc[6];
+        crc[6]   = crc[5];
+        crc[5]   = crc[4] ^ feedback;
+        crc[4]   = crc[3] ^ feedback;
+        crc[3]   = crc[2];
+        crc[2]   = crc[1];
+        crc[1]   = crc[0];
+        crc[0]   = feedback;
+    }
+}
+
+/*  Compare the CRC of every lane with a received CRC byte
+
+    @param crc    - the 8 CRC planes
+    @param planes - the 8 bit planes of the received CRC byte, MSB first
+    @returns a mask of lanes where both match
+*/
+uint32_t sdp_crc8_sliced_match(const uint32_t crc[8], const uint32_t planes[8]) {
+    uint32_t mismatch = 0;
+    uint8_t i;
+    for (i = 0; i < 8; i++) {
+        mismatch |= crc[7 - i] ^ planes[i];
+    }
+    return ~mismatch;
+}
+
+/*  Check transposed words from up to 32 sensors
+
+    @param planes - 24 planes per word (two data bytes and the CRC byte)
+    @param words  - the number of words
+    @param lanes  - a mask of the lanes in use
+    @returns a mask of lanes where all CRCs passed
+*/
+uint32_t sdp_check_words_sliced(const uint32_t *planes, size_t words, uint32_t lanes) {
+    uint32_t crc[8];
+    uint32_t success = lanes;
+    for (; words > 0; words--) {
+        sdp_crc8_sliced_init(crc, lanes);
+        sdp_crc8_sliced_update(crc, planes);
+        sdp_crc8_sliced_update(crc, planes + 8);
+        success &= sdp_crc8_sliced_match(crc, planes + 16);
+        planes += 24;
+    }
+    return success;
+}
+
+/*  Check transposed words from up to 64 sensors, see sdp_check_words_sliced()
+
+    @param planes - 24 planes per word (two data bytes and the CRC byte)
+    @param words  - the number of words
+    @param lanes  - a mask of the lanes in use
+    @returns a mask of lanes where all CRCs passed
+*/
+uint64_t sdp_check_words_sliced64(const uint64_t *planes, size_t words, uint64_t lanes) {
+    uint64_t c0, c1, c2, c3, c4, c5, c6, c7, feedback, mismatch;
+    uint64_t success = lanes;
+    uint8_t i;
+    // Same as above with the register kept in locals, so 64-bit hosts keep it all in registers
+    for (; words > 0; words--) {
+        c0 = c1 = c2 = c3 = c4 = c5 = c6 = c7 = lanes;
+        for (i = 0; i < 16; i++) {
+            feedback = c7 ^ planes[i];
+            c7       = c6;
+            c6       = c5;
+            c5       = c4 ^ feedback;
+            c4       = c3 ^ feedback;
+            c3       = c2;
+            c2       = c1;
+            c1       = c0;
+            c0       = feedback;
+        }
+        mismatch = (c7 ^ planes[16]) | (c6 ^ planes[17]) | (c5 ^ planes[18]) |
+                   (c4 ^ planes[19]) | (c3 ^ planes[20]) | (c2 ^ planes[21]) |
+                   (c1 ^ planes[22]) | (c0 ^ planes[23]);
+        success &= ~mismatch;
+        planes += 24;
+    }
+    return success;
+}
+
+/*  Convert raw pressure values to Pa
+
+    @param raw   - the raw pressure values
+    @param n     - the number of values
+    @param scale - the pressure scale of the sensor, in units of 1/Pa
+    @param out   - a buffer of n values to store the pressures
+*/
+void sdp_pressure_to_pa(const int16_t *raw, size_t n, uint16_t scale, float *out) {
+    // One multiply per sample instead of one divide
+    float factor = 1.0f / (float)scale;
+    size_t i;
+    for (i = 0; i < n; i++) {
+        out[i] = (float)raw[i] * factor;
+    }
+}
+
+/*  Convert raw temperature values to degrees C
+
+    @param raw - the raw temperature values
+    @param n   - the number of values
+    @param out - a buffer of n values to store the temperatures
+*/
+void sdp_temperature_to_c(const int16_t *raw, size_t n, float *out) {
+    float factor = 1.0f / SDP_TEMP_SCALE;
+    size_t i;
+    for (i = 0; i < n; i++) {
+        out[i] = (float)raw[i] * factor;
+    }
+}
+
+/*  Compute the CRC-8 of an SDPFlashLog block, with its "crc" byte taken as 0
+
+    @param block - the block, header first
+    @param len   - the size of the header plus the entries in use
+    @returns the CRC-8 of the block
+*/
+uint8_t sdp_log_block_crc(const uint8_t *block, size_t len) {
+    uint8_t crc = 0xFF;
+    size_t i;
+    for (i = 0; i < len; i++) {
+        // Byte 3 of the header is the CRC itself
+        crc = SDP_CRC_LUT[crc ^ ((i == 3) ? 0 : block[i])];
+    }
+    return crc;
+}
+
+/*  Read little endian fields of a log block */
+static uint16_t sdp_get16(const uint8_t *p) {
+    return (uint16_t)(p[0] | ((uint16_t)p[1] << 8));
+}
+
+static uint32_t sdp_get32(const uint8_t *p) {
+    return (uint32_t)sdp_get16(p) | ((uint32_t)sdp_get16(p + 2) << 16);
+}
+
+/*  Check and decode an SDPFlashLog block, as dumped from flash
+
+    Block Format:
+    | Byte  | 0 1   | 2     | 3   | 4 5 6 7 | 8 9 10 11 | 12 13 | 14 15 | ... |
+    | Value | magic | count | crc | seq     | time      | delta | value | ... |
+
+    @param page  - the page holding the block
+    @param len   - the size of the page
+    @param time  - a buffer of "max" values to store the sample times
+    @param value - a buffer of "max" values to store the raw sample values
+    @param max   - the size of the output buffers
+    @returns the number of samples decoded, 0 for a blank, torn or truncated block
+*/
+size_t sdp_decode_log_block(const uint8_t *page, size_t len, uint32_t *time, int16_t *value,
+                            size_t max) {
+    size_t count, used, i;
+    uint32_t t;
+    if ((len < SDP_LOG_HEADER_SIZE) || (sdp_get16(page) != SDP_LOG_BLOCK_MAGIC)) {
+        return 0;
+    }
+    count = page[2];
+    used  = SDP_LOG_HEADER_SIZE + count * SDP_LOG_ENTRY_SIZE;
+    if ((used > len) || (count > max) || (sdp_log_block_crc(page, used) != page[3])) {
+        return 0;
+    }
+    t = sdp_get32(page + 8);
+    page += SDP_LOG_HEADER_SIZE;
+    for (i = 0; i < count; i++) {
+        t += sdp_get16(page);
+        time[i]  = t;
+        value[i] = (int16_t)sdp_get16(page + 2);
+        page += SDP_LOG_ENTRY_SIZE;
+    }
+    return count;
+}
+
+/*  Zig-zag mapping, so small negative numbers become small unsigned ones */
+static uint32_t sdp_zigzag(uint32_t v) {
+    return (v << 1) ^ (0u - (v >> 31));
+}
+
+static uint32_t sdp_unzigzag(uint32_t z) {
+    return (z >> 1) ^ (0u - (z & 1));
+}
+
+/*  Append a variable length integer, 7 bits per byte with the MSB set on all but the last
+
+    @returns the new position, or NULL iff it does not fit
+*/
+static uint8_t *sdp_put_varint(uint8_t *p, const uint8_t *end, uint32_t v) {
+    while (v >= 0x80) {
+        if (p == end) {
+            return NULL;
+        }
+        *p++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    if (p == end) {
+        return NULL;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+/*  Read a variable length integer
+
+    @returns the new position, or NULL iff truncated
+*/
+static const uint8_t *sdp_get_varint(const uint8_t *p, const uint8_t *end, uint32_t *v) {
+    uint32_t result = 0;
+    uint8_t  shift  = 0;
+    while ((p != end) && (shift < 35)) {
+        uint8_t b = *p++;
+        result |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) {
+            *v = result;
+            return p;
+        }
+        shift += 7;
+    }
+    return NULL;
+}
+
+/*  Pack samples into a compact block
+
+    Block Format:
+    | Byte  | 0 1 2 3 | 4 5   | ...                                                      |
+    | Value | time    | value | varint delta-of-delta time, varint delta value, per sample |
+
+    @param time  - the sample times, wrapping is fine
+    @param value - the raw sample values
+    @param n     - the number of samples
+    @param out   - a buffer to store the block
+    @param size  - the size of out, SDP_PACK_MAX_SIZE(n) always fits
+    @returns the size of the block, 0 iff it does not fit in out
+*/
+size_t sdp_pack_samples(const uint32_t *time, const int16_t *value, size_t n, uint8_t *out,
+                        size_t size) {
+    const uint8_t *end = out + size;
+    uint8_t       *p   = out + 6;
+    uint32_t       delta = 0;
+    size_t         i;
+    if ((n == 0) || (size < 6)) {
+        return 0;
+    }
+    out[0] = (uint8_t)time[0];
+    out[1] = (uint8_t)(time[0] >> 8);
+    out[2] = (uint8_t)(time[0] >> 16);
+    out[3] = (uint8_t)(time[0] >> 24);
+    out[4] = (uint8_t)value[0];
+    out[5] = (uint8_t)((uint16_t)value[0] >> 8);
+    for (i = 1; i < n; i++) {
+        uint32_t d  = time[i] - time[i - 1];
+        // Value deltas wrap at 16 bits, so they never take more than 3 bytes
+        uint16_t dv = (uint16_t)((uint16_t)value[i] - (uint16_t)value[i - 1]);
+        p = sdp_put_varint(p, end, sdp_zigzag(d - delta));
+        if (p == NULL) {
+            return 0;
+        }
+        p = sdp_put_varint(p, end, sdp_zigzag((uint32_t)(int32_t)(int16_t)dv));
+        if (p == NULL) {
+            return 0;
+        }
+        delta = d;
+    }
+    return (size_t)(p - out);
+}
+
+/*  Unpack a block built by sdp_pack_samples()
+
+    @param block - the block
+    @param len   - the size of the block
+    @param time  - a buffer of "max" values to store the sample times
+    @param value - a buffer of "max" values to store the raw sample values
+    @param max   - the size of the output buffers
+    @returns the number of samples decoded, stopping early at a truncated sample or at max
+*/
+size_t sdp_unpack_samples(const uint8_t *block, size_t len, uint32_t *time, int16_t *value,
+                          size_t max) {
+    const uint8_t *end = block + len;
+    const uint8_t *p   = block + 6;
+    uint32_t       t, delta = 0;
+    uint16_t       v;
+    size_t         i;
+    if ((len < 6) || (max == 0)) {
+        return 0;
+    }
+    t = sdp_get32(block);
+    v = sdp_get16(block + 4);
+    time[0]  = t;
+    value[0] = (int16_t)v;
+    for (i = 1; (i < max) && (p != end); i++) {
+        uint32_t dod, dv;
+        p = sdp_get_varint(p, end, &dod);
+        if (p == NULL) {
+            break;
+        }
+        p = sdp_get_varint(p, end, &dv);
+        if (p == NULL) {
+            break;
+        }
+        delta += sdp_unzigzag(dod);
+        t += delta;
+        v = (uint16_t)(v + sdp_unzigzag(dv));
+        time[i]  = t;
+        value[i] = (int16_t)v;
+    }
+    return i;
+}
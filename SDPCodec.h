@@ -0,0 +1,194 @@
+/*
+    SDPCodec.h - Plain C decoding of SDP sensor data, for boards and host tools alike.
+
+    Copyright (c) 2026 SDP3x-Arduino contributors
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef SDPCODEC_H
+#define SDPCODEC_H
+
+/*  Plain C decoding of SDP sensor data
+
+    Nothing in here talks to a bus or depends on Arduino, so the same code that runs on the board
+    can be built into a shared library for host tools:
+
+        cc -O2 -shared -fPIC -o libsdpcodec.so SDPCodec.c
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* CRC-8 Lookup Table (INIT 0xFF, POLY 0x31, no reflection, no final XOR) */
+extern const uint8_t SDP_CRC_LUT[256];
+
+/* Marks a programmed SDPFlashLog block, erased flash reads back as 0xFFFF */
+#define SDP_LOG_BLOCK_MAGIC 0x5DB0
+/* Size of an SDPFlashLog block header and of one sample entry, in bytes */
+#define SDP_LOG_HEADER_SIZE 12
+#define SDP_LOG_ENTRY_SIZE  4
+
+/* Worst case size of n samples packed by sdp_pack_samples(), in bytes */
+#define SDP_PACK_MAX_SIZE(n) (6 + ((n) > 0 ? ((n) - 1) * 8 : 0))
+
+/*  Compute the CRC-8 of a sequence of bytes
+
+    @param data - the bytes to checksum
+    @param len  - the number of bytes in data
+    @returns the CRC-8 of data
+*/
+uint8_t sdp_crc8(const uint8_t *data, size_t len);
+
+/*  Check raw words as read from the sensor
+
+    @param raw   - words * 3 bytes read from the sensor
+    @param words - the number of words in raw
+    @returns the number of words whose CRC failed, 0 iff all passed
+*/
+size_t sdp_check_words(const uint8_t *raw, size_t words);
+
+/*  Check and decode raw words as read from the sensor
+
+    Each word is two bytes, MSB first, followed by its CRC-8. Words are decoded even if a CRC
+    fails, so a frame can be inspected.
+    @param raw   - words * 3 bytes read from the sensor
+    @param words - the number of words in raw
+    @param out   - a buffer of "words" values to store the decoded words
+    @returns the number of words whose CRC failed, 0 iff all passed
+*/
+size_t sdp_decode_words(const uint8_t *raw, size_t words, int16_t *out);
+
+/*  Bit-sliced CRC-8, checking up to 32 frames at once
+
+    Data is transposed into bit planes: lane n of a plane holds one bit of frame n, and the 8
+    planes of a byte go MSB first, as they come off a bit-banged bus. "crc" holds the CRC bit
+    planes, crc[0] being the LSB.
+*/
+
+/*  Start a CRC for every lane
+
+    @param crc   - the 8 CRC planes to initialize
+    @param lanes - a mask of the lanes in use
+*/
+void sdp_crc8_sliced_init(uint32_t crc[8], uint32_t lanes);
+
+/*  Feed one byte of every lane
+
+    @param crc    - the 8 CRC planes
+    @param planes - the 8 bit planes of the byte, MSB first
+*/
+void sdp_crc8_sliced_update(uint32_t crc[8], const uint32_t planes[8]);
+
+/*  Compare the CRC of every lane with a received CRC byte
+
+    @param crc    - the 8 CRC planes
+    @param planes - the 8 bit planes of the received CRC byte, MSB first
+    @returns a mask of lanes where both match
+*/
+uint32_t sdp_crc8_sliced_match(const uint32_t crc[8], const uint32_t planes[8]);
+
+/*  Check transposed words from up to 32 sensors
+
+    @param planes - 24 planes per word (two data bytes and the CRC byte)
+    @param words  - the number of words
+    @param lanes  - a mask of the lanes in use
+    @returns a mask of lanes where all CRCs passed
+*/
+uint32_t sdp_check_words_sliced(const uint32_t *planes, size_t words, uint32_t lanes);
+
+/*  Check transposed words from up to 64 sensors, see sdp_check_words_sliced()
+
+    @param planes - 24 planes per word (two data bytes and the CRC byte)
+    @param words  - the number of words
+    @param lanes  - a mask of the lanes in use
+    @returns a mask of lanes where all CRCs passed
+*/
+uint64_t sdp_check_words_sliced64(const uint64_t *planes, size_t words, uint64_t lanes);
+
+/*  Convert raw pressure values to Pa
+
+    @param raw   - the raw pressure values
+    @param n     - the number of values
+    @param scale - the pressure scale of the sensor, in units of 1/Pa
+    @param out   - a buffer of n values to store the pressures
+*/
+void sdp_pressure_to_pa(const int16_t *raw, size_t n, uint16_t scale, float *out);
+
+/*  Convert raw temperature values to degrees C
+
+    @param raw - the raw temperature values
+    @param n   - the number of values
+    @param out - a buffer of n values to store the temperatures
+*/
+void sdp_temperature_to_c(const int16_t *raw, size_t n, float *out);
+
+/*  Compute the CRC-8 of an SDPFlashLog block, with its "crc" byte taken as 0
+
+    @param block - the block, header first
+    @param len   - the size of the header plus the entries in use
+    @returns the CRC-8 of the block
+*/
+uint8_t sdp_log_block_crc(const uint8_t *block, size_t len);
+
+/*  Check and decode an SDPFlashLog block, as dumped from flash
+
+    Fields are little endian, as written by the boards this library runs on.
+    @param page  - the page holding the block
+    @param len   - the size of the page
+    @param time  - a buffer of "max" values to store the sample times
+    @param value - a buffer of "max" values to store the raw sample values
+    @param max   - the size of the output buffers
+    @returns the number of samples decoded, 0 for a blank, torn or truncated block
+*/
+size_t sdp_decode_log_block(const uint8_t *page, size_t len, uint32_t *time, int16_t *value,
+                            size_t max);
+
+/*  Pack samples into a compact block
+
+    Times are stored as zig-zag delta-of-deltas and values as zig-zag deltas, each as a
+    variable length integer. Regularly spaced, slowly changing samples take 2 bytes each.
+    @param time  - the sample times, wrapping is fine
+    @param value - the raw sample values
+    @param n     - the number of samples
+    @param out   - a buffer to store the block
+    @param size  - the size of out, SDP_PACK_MAX_SIZE(n) always fits
+    @returns the size of the block, 0 iff it does not fit in out
+*/
+size_t sdp_pack_samples(const uint32_t *time, const int16_t *value, size_t n, uint8_t *out,
+                        size_t size);
+
+/*  Unpack a block built by sdp_pack_samples()
+
+    @param block - the block
+    @param len   - the size of the block
+    @param time  - a buffer of "max" values to store the sample times
+    @param value - a buffer of "max" values to store the raw sample values
+    @param max   - the size of the output buffers
+    @returns the number of samples decoded, stopping early at a truncated sample or at max
+*/
+size_t sdp_unpack_samples(const uint8_t *block, size_t len, uint32_t *time, int16_t *value,
+                          size_t max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,149 @@
+/*
+    SDPCompressor.cpp - Deadband and swinging-door compression of SDP sensor samples.
+
+    Copyright (c) 2026 SDP3x-Arduino contributors
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SDPCompressor.h"
+
+/*  Compare two slopes without dividing
+
+    @returns true, iff aNum / aDen < bNum / bDen (both denominators are positive)
+*/
+static bool slopeLess(int32_t aNum, uint32_t aDen, int32_t bNum, uint32_t bDen) {
+    return (int64_t)aNum * (int64_t)bDen < (int64_t)bNum * (int64_t)aDen;
+}
+
+/*  Constructor
+
+    @param mode       - Deadband or SwingingDoor
+    @param maxError   - the maximum reconstruction error in raw counts
+    @param maxSilence - the maximum time between two emitted points
+    @returns a new SDPCompressor as configured
+*/
+SDPCompressor::SDPCompressor(const CompressionMode mode, const uint16_t maxError,
+                             const uint32_t maxSilence) {
+    this->mode       = mode;
+    this->maxError   = maxError;
+    this->maxSilence = maxSilence;
+    reset();
+}
+
+/* Forget all state, the next sample will be emitted */
+void SDPCompressor::reset() {
+    this->started = false;
+    this->pending = false;
+}
+
+/*  Restart both doors from the archived point towards a sample
+
+    @param time  - the sample time
+    @param value - the sample value
+*/
+void SDPCompressor::openDoors(uint32_t time, int16_t value) {
+    uint32_t dt = time - this->archived.time;
+    int32_t dv  = (int32_t)value - (int32_t)this->archived.value;
+    // Two samples with the same timestamp still need a usable slope
+    if (dt == 0) {
+        dt = 1;
+    }
+    this->upNum  = dv + this->maxError;
+    this->upDen  = dt;
+    this->lowNum = dv - this->maxError;
+    this->lowDen = dt;
+}
+
+/*  Feed the next sample
+
+    @param time  - the sample time, may wrap around like micros()
+    @param value - the raw sample value
+    @param out   - a pointer to store the point to emit
+    @returns true, iff "out" holds a point that must be sent
+*/
+bool SDPCompressor::add(uint32_t time, int16_t value, SamplePoint *out) {
+    uint32_t dt;
+    int32_t dv;
+    if (!this->started) {
+        this->started        = true;
+        this->archived.time  = time;
+        this->archived.value = value;
+        *out                 = this->archived;
+        return true;
+    }
+    dt = time - this->archived.time;
+    dv = (int32_t)value - (int32_t)this->archived.value;
+    if (this->mode == Deadband) {
+        if ((dv > this->maxError) || (-dv > this->maxError) || (dt >= this->maxSilence)) {
+            this->archived.time  = time;
+            this->archived.value = value;
+            *out                 = this->archived;
+            return true;
+        }
+        return false;
+    }
+    if (!this->pending) {
+        openDoors(time, value);
+        this->held.time  = time;
+        this->held.value = value;
+        this->pending    = true;
+        return false;
+    }
+    if (dt == 0) {
+        dt = 1;
+    }
+    /*  The line from the archived point to this sample must pass within maxError of every sample
+        since, ie. its slope must lie between the doors. Otherwise the held sample is the furthest
+        point that can be reached and it gets emitted.
+    */
+    if (slopeLess(dv, dt, this->lowNum, this->lowDen) ||
+        slopeLess(this->upNum, this->upDen, dv, dt) || (dt > this->maxSilence)) {
+        this->archived = this->held;
+        *out           = this->archived;
+        openDoors(time, value);
+        this->held.time  = time;
+        this->held.value = value;
+        return true;
+    }
+    // Narrow the doors with this sample's own error band
+    if (slopeLess(dv + this->maxError, dt, this->upNum, this->upDen)) {
+        this->upNum = dv + this->maxError;
+        this->upDen = dt;
+    }
+    if (slopeLess(this->lowNum, this->lowDen, dv - this->maxError, dt)) {
+        this->lowNum = dv - this->maxError;
+        this->lowDen = dt;
+    }
+    this->held.time  = time;
+    this->held.value = value;
+    return false;
+}
+
+/*  Emit the pending sample, if any, eg. before going to sleep
+
+    @param out - a pointer to store the point to emit
+    @returns true, iff "out" holds a point that must be sent
+*/
+bool SDPCompressor::flush(SamplePoint *out) {
+    if (!this->pending) {
+        return false;
+    }
+    this->archived = this->held;
+    this->pending  = false;
+    *out           = this->archived;
+    return true;
+}
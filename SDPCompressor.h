@@ -0,0 +1,109 @@
+/*
+    SDPCompressor.h - Deadband and swinging-door compression of SDP sensor samples.
+
+    Copyright (c) 2026 SDP3x-Arduino contributors
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef SDPCOMPRESSOR_H
+#define SDPCOMPRESSOR_H
+
+#include "Arduino.h"
+
+/*  CompressionMode selects how SDPCompressor decides to emit a point
+
+    Deadband     - emit when a sample leaves the band around the last emitted value, the stream is
+                   reconstructed by holding the last emitted value
+    SwingingDoor - emit when no straight line from the last emitted point fits all samples since,
+                   the stream is reconstructed by linear interpolation between emitted points
+*/
+typedef enum { Deadband, SwingingDoor } CompressionMode;
+
+/* A raw sample and the time it was taken at (eg. micros() or millis()) */
+typedef struct {
+    uint32_t time;
+    int16_t value;
+} SamplePoint;
+
+/*  The SDPCompressor class thins out a stream of raw samples for a slow uplink
+
+    Each call to add() costs O(1) time and no allocations. Reconstruction error is bounded by
+    maxError raw counts and two emitted points are never more than maxSilence time units apart,
+    as long as samples themselves arrive at least that often.
+*/
+class SDPCompressor {
+    private:
+        /* Last emitted point */
+        SamplePoint archived;
+        /* Last sample seen but not emitted yet (SwingingDoor only) */
+        SamplePoint held;
+        /* Upper door slope, upNum / upDen */
+        int32_t upNum;
+        uint32_t upDen;
+        /* Lower door slope, lowNum / lowDen */
+        int32_t lowNum;
+        uint32_t lowDen;
+        /* Maximum reconstruction error in raw counts */
+        uint16_t maxError;
+        /* Maximum time between two emitted points */
+        uint32_t maxSilence;
+        /* The compression mode to use */
+        CompressionMode mode;
+        /* true once the first point has been emitted */
+        bool started;
+        /* true iff "held" holds a pending sample */
+        bool pending;
+
+        /*  Restart both doors from the archived point towards a sample
+
+            @param time  - the sample time
+            @param value - the sample value
+        */
+        void openDoors(uint32_t time, int16_t value);
+
+    public:
+        /*  Constructor
+
+            @param mode       - Deadband or SwingingDoor
+            @param maxError   - the maximum reconstruction error in raw counts
+            @param maxSilence - the maximum time between two emitted points
+            @returns a new SDPCompressor as configured
+        */
+        SDPCompressor(const CompressionMode mode, const uint16_t maxError,
+                      const uint32_t maxSilence);
+
+        /*  Feed the next sample
+
+            @param time  - the sample time, may wrap around like micros()
+            @param value - the raw sample value
+            @param out   - a pointer to store the point to emit
+            @returns true, iff "out" holds a point that must be sent
+        */
+        bool add(uint32_t time, int16_t value, SamplePoint *out);
+
+        /*  Emit the pending sample, if any, eg. before going to sleep
+
+            @param out - a pointer to store the point to emit
+            @returns true, iff "out" holds a point that must be sent
+        */
+        bool flush(SamplePoint *out);
+
+        /* Forget all state, the next sample will be emitted */
+        void reset();
+};
+
+#endif
@@ -0,0 +1,179 @@
+/*
+    SDPController.cpp - Fixed-point PID control of fans and dampers from SDP sensor readings.
+
+    Copyright (c) 2026 SDP3x-Arduino contributors
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SDPController.h"
+
+/*  Constructor
+
+    @param period - the time between two samples (eg. 1000 for 1 kHz with micros())
+    @returns a new SDPSampler as configured
+*/
+SDPSampler::SDPSampler(const uint32_t period) {
+    this->period  = period;
+    this->next    = 0;
+    this->started = false;
+}
+
+/*  Check whether a sample is due
+
+    @param now - the current time (eg. micros())
+    @returns true, iff a sample must be taken now
+*/
+bool SDPSampler::due(uint32_t now) {
+    if (!this->started) {
+        this->started = true;
+        this->next    = now + this->period;
+        return true;
+    }
+    if ((int32_t)(now - this->next) < 0) {
+        return false;
+    }
+    this->next += this->period;
+    // Too far behind: skip the missed samples instead of bursting through them
+    if ((int32_t)(now - this->next) >= 0) {
+        this->next = now + this->period;
+    }
+    return true;
+}
+
+/*  Constructor
+
+    @param kp     - proportional gain, Q16.16
+    @param ki     - integral gain, Q16.16 per second
+    @param kd     - derivative gain, Q16.16 seconds
+    @param outMin - the lowest output the actuator accepts
+    @param outMax - the highest output the actuator accepts
+    @returns a new SDPController as configured
+*/
+SDPController::SDPController(const int32_t kp, const int32_t ki, const int32_t kd,
+                             const int32_t outMin, const int32_t outMax) {
+    this->kp        = kp;
+    this->ki        = ki;
+    this->kd        = kd;
+    this->outMin    = outMin;
+    this->outMax    = outMax;
+    this->setpoint  = 0;
+    this->delay     = 0;
+    this->modelGain = 0;
+    this->modelRate = 0;
+    reset();
+}
+
+/* Forget the integral and the plant model, eg. when the loop was paused */
+void SDPController::reset() {
+    uint8_t i;
+    this->integral = 0;
+    this->model    = 0;
+    this->head     = 0;
+    this->started  = false;
+    for (i = 0; i < SDP_CONTROL_MAX_DELAY; i++) {
+        this->history[i] = 0;
+    }
+}
+
+/*  Set the target
+
+    @param setpoint - the target in raw sensor counts
+*/
+void SDPController::setSetpoint(int16_t setpoint) {
+    this->setpoint = setpoint;
+}
+
+/*  Compensate for a known sensor plus actuator dead time
+
+    @param samples - the dead time in samples, at most SDP_CONTROL_MAX_DELAY, 0 to disable
+    @param gain    - the steady-state plant gain in raw counts per actuator unit, Q16.16
+    @param tau     - the plant time constant in microseconds
+*/
+void SDPController::setDeadTime(uint8_t samples, int32_t gain, uint32_t tau) {
+    if (samples > SDP_CONTROL_MAX_DELAY) {
+        samples = SDP_CONTROL_MAX_DELAY;
+    }
+    this->delay     = samples;
+    this->modelGain = gain;
+    // The only division, done once here rather than on every sample
+    this->modelRate = (tau == 0) ? 0 : (uint32_t)((65536ULL * 1000000ULL) / tau);
+    reset();
+}
+
+/*  Compute the next output
+
+    @param time        - the time the measurement was taken in microseconds (micros())
+    @param measurement - the raw pressure measurement
+    @returns the output to apply, within [outMin, outMax]
+*/
+int32_t SDPController::update(uint32_t time, int16_t measurement) {
+    uint32_t dt;
+    int64_t dtQ16, step, integral, output;
+    int32_t feedback, error, delayed, target;
+    if (!this->started) {
+        this->lastTime = time;
+    }
+    dt = time - this->lastTime;
+    // Microseconds to Q16.16 seconds: 2^36 / 10^6 ~ 68719 / 2^20
+    dtQ16 = ((uint64_t)dt * 68719) >> 20;
+    feedback = measurement;
+    if (this->delay > 0) {
+        // Add what the model says is still on its way to the sensor
+        delayed                   = this->history[this->head];
+        this->history[this->head] = this->model;
+        this->head                = (this->head + 1 == this->delay) ? 0 : this->head + 1;
+        feedback += (this->model - delayed) >> 8;
+    }
+    if (!this->started) {
+        this->lastFeedback = feedback;
+        this->started      = true;
+    }
+    error    = (int32_t)this->setpoint - feedback;
+    integral = this->integral + (((int64_t)this->ki * error * dtQ16) >> 16);
+    output   = (int64_t)this->kp * error + integral;
+    // Derivative on the feedback rather than the error, so setpoint steps do not kick
+    if ((this->kd != 0) && (dt > 0)) {
+        output -= (int64_t)this->kd * (feedback - this->lastFeedback) * 1000000 / dt;
+    }
+    output >>= 16;
+    if (output > this->outMax) {
+        output = this->outMax;
+        // Only integrate when it pulls the output back out of saturation
+        if (error < 0) {
+            this->integral = integral;
+        }
+    } else if (output < this->outMin) {
+        output = this->outMin;
+        if (error > 0) {
+            this->integral = integral;
+        }
+    } else {
+        this->integral = integral;
+    }
+    if (this->delay > 0) {
+        // First-order plant model, model += (gain * output - model) * dt / tau
+        step = (dtQ16 * this->modelRate) >> 16;
+        if (step > 65536) {
+            step = 65536;
+        }
+        target = (int32_t)(((int64_t)this->modelGain * output) >> 8);
+        this->model += (int32_t)(((int64_t)(target - this->model) * step) >> 16);
+    }
+    this->lastTime     = time;
+    this->lastFeedback = feedback;
+    return (int32_t)output;
+}
@@ -0,0 +1,143 @@
+/*
+    SDPController.h - Fixed-point PID control of fans and dampers from SDP sensor readings.
+
+    Copyright (c) 2026 SDP3x-Arduino contributors
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef SDPCONTROLLER_H
+#define SDPCONTROLLER_H
+
+#include "Arduino.h"
+
+/*  The longest sensor plus actuator dead time the controller can compensate, in samples
+
+    Define it before including this file to change it, it costs 4 bytes of RAM per sample.
+*/
+#ifndef SDP_CONTROL_MAX_DELAY
+#define SDP_CONTROL_MAX_DELAY 16
+#endif
+
+/*  The SDPSampler class tells when the next sample of a fixed-rate loop is due
+
+    The schedule advances by whole periods from the first call, so late samples do not make the
+    rate drift, and samples missed entirely are skipped rather than run back to back.
+*/
+class SDPSampler {
+    private:
+        /* Time the next sample is due */
+        uint32_t next;
+        /* Time between two samples */
+        uint32_t period;
+        /* true once the schedule has started */
+        bool started;
+
+    public:
+        /*  Constructor
+
+            @param period - the time between two samples (eg. 1000 for 1 kHz with micros())
+            @returns a new SDPSampler as configured
+        */
+        SDPSampler(const uint32_t period);
+
+        /*  Check whether a sample is due
+
+            @param now - the current time (eg. micros())
+            @returns true, iff a sample must be taken now
+        */
+        bool due(uint32_t now);
+};
+
+/*  The SDPController class is a fixed-point PID controller for pressure loops
+
+    Gains are Q16.16 numbers: the output in actuator units is
+        Kp * e + Ki * integral(e dt) - Kd * d(measurement)/dt
+    with e and the measurement in raw sensor counts and t in seconds, so Ki is per second and Kd
+    in seconds. The time between samples is taken from the sample timestamps, which must be in
+    microseconds, so jitter does not skew the integral and derivative terms.
+
+    The integral stops growing while the output is saturated (anti-windup). With setDeadTime(),
+    a first-order plant model predicts the effect of recent outputs that has not reached the
+    sensor yet (Smith predictor), which keeps loops with transport delay stable at higher gain.
+*/
+class SDPController {
+    private:
+        /* Gains, Q16.16 */
+        int32_t kp;
+        int32_t ki;
+        int32_t kd;
+        /* Output limits, in actuator units */
+        int32_t outMin;
+        int32_t outMax;
+        /* Target, in raw sensor counts */
+        int16_t setpoint;
+        /* Integral term, Q16.16 actuator units */
+        int64_t integral;
+        /* Previous timestamp and feedback value */
+        uint32_t lastTime;
+        int32_t lastFeedback;
+        /* Plant model: gain Q16.16 counts per actuator unit, 1/tau Q16.16 per second */
+        int32_t modelGain;
+        uint32_t modelRate;
+        /* Plant model output, Q8 raw counts, now and over the last "delay" samples */
+        int32_t model;
+        int32_t history[SDP_CONTROL_MAX_DELAY];
+        uint8_t delay;
+        uint8_t head;
+        /* true once the first sample has been seen */
+        bool started;
+
+    public:
+        /*  Constructor
+
+            @param kp     - proportional gain, Q16.16
+            @param ki     - integral gain, Q16.16 per second
+            @param kd     - derivative gain, Q16.16 seconds
+            @param outMin - the lowest output the actuator accepts
+            @param outMax - the highest output the actuator accepts
+            @returns a new SDPController as configured
+        */
+        SDPController(const int32_t kp, const int32_t ki, const int32_t kd, const int32_t outMin,
+                      const int32_t outMax);
+
+        /*  Set the target
+
+            @param setpoint - the target in raw sensor counts
+        */
+        void setSetpoint(int16_t setpoint);
+
+        /*  Compensate for a known sensor plus actuator dead time
+
+            @param samples - the dead time in samples, at most SDP_CONTROL_MAX_DELAY, 0 to disable
+            @param gain    - the steady-state plant gain in raw counts per actuator unit, Q16.16
+            @param tau     - the plant time constant in microseconds
+        */
+        void setDeadTime(uint8_t samples, int32_t gain, uint32_t tau);
+
+        /*  Compute the next output
+
+            @param time        - the time the measurement was taken in microseconds (micros())
+            @param measurement - the raw pressure measurement
+            @returns the output to apply, within [outMin, outMax]
+        */
+        int32_t update(uint32_t time, int16_t measurement);
+
+        /* Forget the integral and the plant model, eg. when the loop was paused */
+        void reset();
+};
+
+#endif
@@ -0,0 +1,103 @@
+/*
+    SDPCorrelator.cpp - Transport delay estimation between pairs of SDP sensors.
+
+    Copyright (c) 2026 SDP3x-Arduino contributors
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SDPCorrelator.h"
+
+/*  Constructor
+
+    @param decimation - raw samples averaged into one, the lag resolution
+    @param shift      - forget old samples with a time constant of 2^shift decimated samples
+    @returns a new SDPCorrelator as configured
+*/
+SDPCorrelator::SDPCorrelator(const uint8_t decimation, const uint8_t shift) {
+    this->decimation = (decimation == 0) ? 1 : decimation;
+    this->shift      = shift;
+    reset();
+}
+
+/* Forget all state */
+void SDPCorrelator::reset() {
+    uint8_t i;
+    for (i = 0; i < SDP_XCORR_MAX_LAG; i++) {
+        this->upstream[i] = 0;
+        this->corr[i]     = 0;
+    }
+    this->meanUp   = 0;
+    this->meanDown = 0;
+    this->sumUp    = 0;
+    this->sumDown  = 0;
+    this->count    = 0;
+    this->head     = 0;
+    this->peak     = 0;
+}
+
+/*  Feed a pair of samples taken at the same time
+
+    @param up   - the raw upstream sample
+    @param down - the raw downstream sample
+    @returns true, iff a decimated sample was completed and the peak may have moved
+*/
+bool SDPCorrelator::add(int16_t up, int16_t down) {
+    int32_t devUp, devDown, best;
+    uint8_t lag, i;
+    this->sumUp += up;
+    this->sumDown += down;
+    if (++this->count < this->decimation) {
+        return false;
+    }
+    // Work on block sums rather than averages, which scales both streams alike without dividing
+    devUp   = this->sumUp - (this->meanUp >> 8);
+    devDown = this->sumDown - (this->meanDown >> 8);
+    // The step can span twice the int32_t range at full scale, the new mean always fits
+    this->meanUp   = (int32_t)(this->meanUp +
+                             (((int64_t)this->sumUp * 256 - this->meanUp) >> this->shift));
+    this->meanDown = (int32_t)(this->meanDown +
+                               (((int64_t)this->sumDown * 256 - this->meanDown) >> this->shift));
+    this->sumUp   = 0;
+    this->sumDown = 0;
+    this->count   = 0;
+    // Keep the products well inside 32 bits
+    devUp   = constrain(devUp, -32768, 32767);
+    devDown = constrain(devDown, -32768, 32767);
+    this->head                 = (this->head == 0) ? SDP_XCORR_MAX_LAG - 1 : this->head - 1;
+    this->upstream[this->head] = devUp;
+    best                       = INT32_MIN;
+    i                          = this->head;
+    for (lag = 0; lag < SDP_XCORR_MAX_LAG; lag++) {
+        // upstream[i] is the upstream sample "lag" decimated samples ago
+        this->corr[lag] += ((((int32_t)this->upstream[i] * devDown) >> 4) - this->corr[lag]) >>
+                           this->shift;
+        if (this->corr[lag] > best) {
+            best       = this->corr[lag];
+            this->peak = lag;
+        }
+        i = (i + 1 == SDP_XCORR_MAX_LAG) ? 0 : i + 1;
+    }
+    return true;
+}
+
+/*  Get the current delay estimate
+
+    @returns the delay of the downstream sensor in raw samples
+*/
+uint16_t SDPCorrelator::getLag() {
+    return (uint16_t)this->peak * this->decimation;
+}
@@ -0,0 +1,90 @@
+/*
+    SDPCorrelator.h - Transport delay estimation between pairs of SDP sensors.
+
+    Copyright (c) 2026 SDP3x-Arduino contributors
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef SDPCORRELATOR_H
+#define SDPCORRELATOR_H
+
+#include "Arduino.h"
+
+/*  The number of lags SDPCorrelator tracks
+
+    Define it before including this file to change it, it costs 6 bytes of RAM per lag.
+*/
+#ifndef SDP_XCORR_MAX_LAG
+#define SDP_XCORR_MAX_LAG 64
+#endif
+
+/*  The SDPCorrelator class tracks the transport delay between an upstream and a downstream sensor
+
+    Both streams are decimated by averaging, their slowly moving means are removed, and the
+    cross-correlation at every lag is kept as an exponentially weighted running sum. The lag with
+    the highest correlation is the delay. Each decimated sample costs O(SDP_XCORR_MAX_LAG) integer
+    multiply-adds and no division.
+*/
+class SDPCorrelator {
+    private:
+        /* Decimated, mean-removed upstream samples, newest at "head" */
+        int16_t upstream[SDP_XCORR_MAX_LAG];
+        /* Running cross-correlation at every lag */
+        int32_t corr[SDP_XCORR_MAX_LAG];
+        /* Running means of the block sums, Q8 */
+        int32_t meanUp;
+        int32_t meanDown;
+        /* Sums of the samples of the current decimation block */
+        int32_t sumUp;
+        int32_t sumDown;
+        /* Samples per decimated sample */
+        uint8_t decimation;
+        uint8_t count;
+        /* Weight of a new sample, as a shift: 1 / 2^shift */
+        uint8_t shift;
+        uint8_t head;
+        /* Lag with the highest correlation, in decimated samples */
+        uint8_t peak;
+
+    public:
+        /*  Constructor
+
+            @param decimation - raw samples averaged into one, the lag resolution
+            @param shift      - forget old samples with a time constant of 2^shift decimated samples
+            @returns a new SDPCorrelator as configured
+        */
+        SDPCorrelator(const uint8_t decimation, const uint8_t shift);
+
+        /*  Feed a pair of samples taken at the same time
+
+            @param up   - the raw upstream sample
+            @param down - the raw downstream sample
+            @returns true, iff a decimated sample was completed and the peak may have moved
+        */
+        bool add(int16_t up, int16_t down);
+
+        /*  Get the current delay estimate
+
+            @returns the delay of the downstream sensor in raw samples
+        */
+        uint16_t getLag();
+
+        /* Forget all state */
+        void reset();
+};
+
+#endif
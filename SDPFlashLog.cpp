@@ -0,0 +1,238 @@
+/*
+    SDPFlashLog.cpp - Wear-levelled ring log of SDP sensor samples in flash.
+
+    Copyright (c) 2026 SDP3x-Arduino contributors
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SDPFlashLog.h"
+
+/*  Constructor
+
+    @param flash - the flash part to keep the log on
+    @returns a new SDPFlashLog, begin() must be called before use
+*/
+SDPFlashLog::SDPFlashLog(SDPFlash &flash) {
+    this->flash    = &flash;
+    this->sector   = 0;
+    this->page     = 0;
+    this->seq      = 0;
+    this->lastTime = 0;
+    memset(this->pending.raw, 0xFF, SDP_LOG_PAGE_SIZE);
+    this->pending.block.header.count = 0;
+}
+
+/* @returns the number of pages in a sector */
+uint16_t SDPFlashLog::pagesPerSector() {
+    return this->flash->sectorSize() / SDP_LOG_PAGE_SIZE;
+}
+
+/*  Read a block back and check its CRC
+
+    @param sector - the sector index
+    @param page   - the page index in the sector
+    @param block  - a pointer to store the block
+    @returns true, iff a valid block was found
+*/
+bool SDPFlashLog::readBlock(uint16_t sector, uint16_t page, LogBlock *block) {
+    uint32_t addr =
+        (uint32_t)sector * this->flash->sectorSize() + (uint32_t)page * SDP_LOG_PAGE_SIZE;
+    if (!this->flash->read(addr, (uint8_t *)&block->header, sizeof(LogBlockHeader))) {
+        return false;
+    }
+    if ((block->header.magic != SDP_LOG_BLOCK_MAGIC) || (block->header.count > LogBlockSamples)) {
+        return false;
+    }
+    if (!this->flash->read(addr + sizeof(LogBlockHeader),
+                           (uint8_t *)block->entries,
+                           block->header.count * sizeof(LogEntry))) {
+        return false;
+    }
+    return sdp_log_block_crc((const uint8_t *)block,
+                             sizeof(LogBlockHeader) + block->header.count * sizeof(LogEntry)) ==
+           block->header.crc;
+}
+
+/*  Find the sequence number of a sector
+
+    Page 0 normally holds it, but a write to page 0 that failed or was torn by a reset leaves it
+    to the next valid page.
+    @param sector - the sector index
+    @param seq    - a pointer to store the sequence number
+    @returns true, iff the sector holds a valid block
+*/
+bool SDPFlashLog::sectorSeq(uint16_t sector, uint32_t *seq) {
+    LogBlock block;
+    uint16_t pages = pagesPerSector();
+    uint16_t p;
+    for (p = 0; p < pages; p++) {
+        if (readBlock(sector, p, &block)) {
+            *seq = block.header.seq;
+            return true;
+        }
+    }
+    return false;
+}
+
+/*  Find the end of the log after a reset
+
+    Reads the first valid block of each sector, then the headers of the newest sector only.
+    @returns true, iff everything went correctly
+*/
+bool SDPFlashLog::begin() {
+    LogBlock block;
+    uint16_t sectors = this->flash->sectorCount();
+    uint16_t pages   = pagesPerSector();
+    uint16_t s;
+    uint32_t seq;
+    bool found = false;
+    // The newest sector has the highest sequence number, allowing for wrap around
+    for (s = 0; s < sectors; s++) {
+        if (sectorSeq(s, &seq) && (!found || (int32_t)(seq - this->seq) > 0)) {
+            found        = true;
+            this->seq    = seq;
+            this->sector = s;
+        }
+    }
+    if (!found) {
+        // Blank log, start from scratch
+        this->sector = 0;
+        this->page   = 0;
+        this->seq    = 1;
+        return this->flash->erase(0);
+    }
+    // Resume after the last programmed page, torn pages can not be programmed again
+    for (this->page = 1; this->page < pages; this->page++) {
+        uint32_t addr = (uint32_t)this->sector * this->flash->sectorSize() +
+                        (uint32_t)this->page * SDP_LOG_PAGE_SIZE;
+        if (!this->flash->read(addr, (uint8_t *)&block.header, sizeof(LogBlockHeader))) {
+            return false;
+        }
+        if (block.header.magic == 0xFFFF) {
+            break;
+        }
+    }
+    return true;
+}
+
+/*  Add a sample to the log
+
+    The sample is written to flash once a full block has been collected.
+    @param time  - the sample time (eg. millis())
+    @param value - the raw sample value
+    @returns true, iff everything went correctly
+*/
+bool SDPFlashLog::append(uint32_t time, int16_t value) {
+    LogBlock *block = &this->pending.block;
+    uint32_t delta  = time - this->lastTime;
+    // Deltas are 16 bits wide, a longer gap starts a new block
+    if ((block->header.count > 0) && (delta > 0xFFFF)) {
+        if (!sync()) {
+            return false;
+        }
+    }
+    if (block->header.count == 0) {
+        block->header.time = time;
+        delta              = 0;
+    }
+    block->entries[block->header.count].delta = (uint16_t)delta;
+    block->entries[block->header.count].value = value;
+    block->header.count++;
+    this->lastTime = time;
+    if (block->header.count == LogBlockSamples) {
+        return sync();
+    }
+    return true;
+}
+
+/*  Write the pending samples now, eg. before going to sleep
+
+    This uses up a whole page even if the block is not full.
+    @returns true, iff everything went correctly
+*/
+bool SDPFlashLog::sync() {
+    LogBlock *block = &this->pending.block;
+    bool success;
+    if (block->header.count == 0) {
+        return true;
+    }
+    // Move on to the next sector, which holds the oldest data
+    if (this->page >= pagesPerSector()) {
+        this->sector = (this->sector + 1) % this->flash->sectorCount();
+        this->page   = 0;
+        this->seq++;
+        if (!this->flash->erase(this->sector)) {
+            return false;
+        }
+    }
+    block->header.magic = SDP_LOG_BLOCK_MAGIC;
+    block->header.seq   = this->seq;
+    block->header.crc   = sdp_log_block_crc(this->pending.raw,
+                                          sizeof(LogBlockHeader) +
+                                              block->header.count * sizeof(LogEntry));
+    success = this->flash->writePage((uint32_t)this->sector * this->flash->sectorSize() +
+                                         (uint32_t)this->page * SDP_LOG_PAGE_SIZE,
+                                     this->pending.raw);
+    // A failed page is skipped rather than retried, it may be partially programmed
+    this->page++;
+    memset(this->pending.raw, 0xFF, SDP_LOG_PAGE_SIZE);
+    block->header.count = 0;
+    return success;
+}
+
+/* @returns the number of blocks in flash, including torn ones */
+uint32_t SDPFlashLog::blocks() {
+    uint16_t sectors = this->flash->sectorCount();
+    uint16_t oldest  = (this->sector + 1) % sectors;
+    uint32_t seq;
+    // Until the ring wraps around for the first time, the sector after the newest one is blank
+    if (!sectorSeq(oldest, &seq)) {
+        oldest = 0;
+    }
+    return (uint32_t)((this->sector + sectors - oldest) % sectors) * pagesPerSector() + this->page;
+}
+
+/*  Read back a block of samples, oldest first
+
+    @param index - the block index, 0 is the oldest block in flash
+    @param out   - a buffer of at least LogBlockSamples points
+    @returns the number of samples read, 0 past the end or for a torn block
+*/
+uint8_t SDPFlashLog::read(uint32_t index, SamplePoint *out) {
+    LogBlock block;
+    uint16_t sectors = this->flash->sectorCount();
+    uint16_t pages   = pagesPerSector();
+    uint16_t oldest  = (this->sector + 1) % sectors;
+    uint32_t time, seq;
+    uint8_t i;
+    if (index >= blocks()) {
+        return 0;
+    }
+    if (!sectorSeq(oldest, &seq)) {
+        oldest = 0;
+    }
+    if (!readBlock((oldest + index / pages) % sectors, index % pages, &block)) {
+        return 0;
+    }
+    time = block.header.time;
+    for (i = 0; i < block.header.count; i++) {
+        time += block.entries[i].delta;
+        out[i].time  = time;
+        out[i].value = block.entries[i].value;
+    }
+    return block.header.count;
+}
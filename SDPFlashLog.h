@@ -0,0 +1,193 @@
+/*
+    SDPFlashLog.h - Wear-levelled ring log of SDP sensor samples in flash.
+
+    Copyright (c) 2026 SDP3x-Arduino contributors
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef SDPFLASHLOG_H
+#define SDPFLASHLOG_H
+
+#include "Arduino.h"
+#include "SDPCodec.h"
+#include "SDPCompressor.h"
+
+/*  Size of a flash page, the unit of a single write
+
+    Define it before including this file if the part has a different page size.
+*/
+#ifndef SDP_LOG_PAGE_SIZE
+#define SDP_LOG_PAGE_SIZE 256
+#endif
+
+/*  The SDPFlash class is the interface SDPFlashLog uses to talk to the flash part
+
+    Implement it on top of the platform flash driver (eg. esp_partition, SPIFlash) or on top of a
+    file to run the log on a host.
+*/
+class SDPFlash {
+    public:
+        /* @returns the size of an erasable sector in bytes, a multiple of SDP_LOG_PAGE_SIZE */
+        virtual uint32_t sectorSize() = 0;
+
+        /* @returns the number of sectors reserved for the log, at least 2 */
+        virtual uint16_t sectorCount() = 0;
+
+        /*  Read bytes back from the flash
+
+            @param addr - the byte offset from the start of the log area
+            @param data - a buffer to store the bytes
+            @param len  - the number of bytes to read
+            @returns true, iff everything went correctly
+        */
+        virtual bool read(uint32_t addr, uint8_t *data, uint16_t len) = 0;
+
+        /*  Program one page
+
+            @param addr - the byte offset from the start of the log area, page aligned
+            @param data - SDP_LOG_PAGE_SIZE bytes to program
+            @returns true, iff everything went correctly
+        */
+        virtual bool writePage(uint32_t addr, const uint8_t *data) = 0;
+
+        /*  Erase one sector to 0xFF
+
+            @param sector - the sector index
+            @returns true, iff everything went correctly
+        */
+        virtual bool erase(uint16_t sector) = 0;
+};
+
+/*  Header of every block in the log
+
+    A block fills exactly one page. "seq" is the sequence number of the sector the block lives
+    in, so reading the first valid block of every sector is enough to find the newest one at boot.
+*/
+typedef struct {
+    uint16_t magic;
+    uint8_t count;
+    uint8_t crc;
+    uint32_t seq;
+    uint32_t time;
+} LogBlockHeader;
+
+/* Samples in a block are stored as a time delta to the previous sample and a raw value */
+typedef struct {
+    uint16_t delta;
+    int16_t value;
+} LogEntry;
+
+// The layout is shared with sdp_decode_log_block() for host tools
+static_assert(sizeof(LogBlockHeader) == SDP_LOG_HEADER_SIZE, "LogBlockHeader must be packed");
+static_assert(sizeof(LogEntry) == SDP_LOG_ENTRY_SIZE, "LogEntry must be packed");
+
+/* The maximum number of samples in one block */
+const uint8_t LogBlockSamples = (SDP_LOG_PAGE_SIZE - sizeof(LogBlockHeader)) / sizeof(LogEntry);
+
+/* A block as laid out in one page */
+typedef struct {
+    LogBlockHeader header;
+    LogEntry entries[LogBlockSamples];
+} LogBlock;
+
+/*  The SDPFlashLog class keeps the most recent samples in a ring of flash sectors
+
+    Samples are batched in RAM and written one full page at a time. Sectors are used in turn, so
+    every sector is erased equally often. A block that was torn by a reset fails its CRC and is
+    skipped when reading back.
+*/
+class SDPFlashLog {
+    private:
+        /* The flash part backing this log */
+        SDPFlash *flash;
+        /* The block being filled, padded to a full page */
+        union {
+            LogBlock block;
+            uint8_t raw[SDP_LOG_PAGE_SIZE];
+        } pending;
+        /* Time of the last appended sample */
+        uint32_t lastTime;
+        /* Sector and page the next block will be written to */
+        uint16_t sector;
+        uint16_t page;
+        /* Sequence number of the current sector */
+        uint32_t seq;
+
+        /*  Read a block back and check its CRC
+
+            @param sector - the sector index
+            @param page   - the page index in the sector
+            @param block  - a pointer to store the block
+            @returns true, iff a valid block was found
+        */
+        bool readBlock(uint16_t sector, uint16_t page, LogBlock *block);
+
+        /*  Find the sequence number of a sector
+
+            @param sector - the sector index
+            @param seq    - a pointer to store the sequence number
+            @returns true, iff the sector holds a valid block
+        */
+        bool sectorSeq(uint16_t sector, uint32_t *seq);
+
+        /* @returns the number of pages in a sector */
+        uint16_t pagesPerSector();
+
+    public:
+        /*  Constructor
+
+            @param flash - the flash part to keep the log on
+            @returns a new SDPFlashLog, begin() must be called before use
+        */
+        SDPFlashLog(SDPFlash &flash);
+
+        /*  Find the end of the log after a reset
+
+            Reads the first valid block of each sector, then the headers of the newest sector only.
+            @returns true, iff everything went correctly
+        */
+        bool begin();
+
+        /*  Add a sample to the log
+
+            The sample is written to flash once a full block has been collected.
+            @param time  - the sample time (eg. millis())
+            @param value - the raw sample value
+            @returns true, iff everything went correctly
+        */
+        bool append(uint32_t time, int16_t value);
+
+        /*  Write the pending samples now, eg. before going to sleep
+
+            This uses up a whole page even if the block is not full.
+            @returns true, iff everything went correctly
+        */
+        bool sync();
+
+        /* @returns the number of blocks in flash, including torn ones */
+        uint32_t blocks();
+
+        /*  Read back a block of samples, oldest first
+
+            @param index - the block index, 0 is the oldest block in flash
+            @param out   - a buffer of at least LogBlockSamples points
+            @returns the number of samples read, 0 past the end or for a torn block
+        */
+        uint8_t read(uint32_t index, SamplePoint *out);
+};
+
+#endif
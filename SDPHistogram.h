@@ -0,0 +1,269 @@
+/*
+    SDPHistogram.h - Fixed-bin histograms of raw SDP sensor pressure.
+
+    Copyright (c) 2026 SDP3x-Arduino contributors
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef SDPHISTOGRAM_H
+#define SDPHISTOGRAM_H
+
+#include "Arduino.h"
+
+/*  HistogramLayout selects how raw pressure values map to bins
+
+    LinearBins - equal width bins over the whole int16_t range, width is a power of two counts
+    LogBins    - bins grow with the magnitude (a few bins per power of two), fine around zero and
+                 coarse towards full scale, symmetric for negative values
+*/
+typedef enum { LinearBins, LogBins } HistogramLayout;
+
+/*  The SDPHistogram class counts raw pressure values into fixed bins
+
+    Adding a sample is O(1) with shifts only, no division. Counters saturate instead of wrapping,
+    so a 16-bit histogram left running for days is still right about where the mass is.
+    Histograms of the same type can be merged, eg. to combine hours into days, and quantiles of
+    the merged result are as good as those of a single histogram over the same samples.
+
+    Counter - uint16_t or uint32_t
+    Bins    - a power of two, at least 32 (the fewest LogBins can map every value to)
+
+    Divide a raw value by getPressureScale() to get Pa.
+*/
+template <typename Counter, uint16_t Bins>
+class SDPHistogram {
+    // bin() relies on both: LinearBins shifts by a whole number of bits and LogBins needs 16
+    // bins per half for the 16 powers of two, fewer would index past "counts"
+    static_assert((Bins & (Bins - 1)) == 0, "Bins must be a power of two");
+    static_assert(Bins >= 32, "Bins must be at least 32");
+
+    private:
+        /* One counter per bin */
+        Counter counts[Bins];
+        /* The layout in use */
+        HistogramLayout layout;
+        /* Linear: log2 of the bin width. Log: log2 of the bins per power of two */
+        uint8_t shift;
+
+        /*  Map a magnitude to its index in one half of a LogBins histogram
+
+            @param m - the magnitude, 0 - 32767
+            @returns the index, 0 for the smallest magnitudes
+        */
+        uint16_t logIndex(uint16_t m) {
+            uint8_t bits;
+            if (m < (1U << this->shift)) {
+                return m;
+            }
+            // Number of significant bits, the highest one is implied by the exponent
+            bits = 8 * sizeof(unsigned int) - __builtin_clz((unsigned int)m);
+            return ((bits - this->shift) << this->shift) +
+                   ((m >> (bits - 1 - this->shift)) & ((1U << this->shift) - 1));
+        }
+
+        /*  Map an index in one half of a LogBins histogram back to its smallest magnitude
+
+            Indices past the largest magnitude exist when Bins is not an exact fit for the layout.
+            They are never counted into and map to 32768, so bins stay in order.
+            @param index - the index, may be one past the last one
+            @returns the magnitude, up to 32768
+        */
+        uint32_t logMagnitude(uint16_t index) {
+            uint8_t bits;
+            uint32_t m;
+            if (index < (1U << this->shift)) {
+                return index;
+            }
+            bits = (index >> this->shift) + this->shift;
+            if (bits > 16) {
+                return 32768;
+            }
+            m = ((uint32_t)1 << (bits - 1)) |
+                ((uint32_t)(index & ((1U << this->shift) - 1)) << (bits - 1 - this->shift));
+            return (m > 32768) ? 32768 : m;
+        }
+
+    public:
+        /*  Constructor
+
+            @param layout - LinearBins or LogBins
+            @returns a new empty SDPHistogram
+        */
+        SDPHistogram(const HistogramLayout layout) {
+            uint16_t bins;
+            this->layout = layout;
+            this->shift  = 0;
+            if (layout == LinearBins) {
+                // 65536 values over Bins bins
+                for (bins = Bins; bins > 1; bins >>= 1) {
+                    this->shift++;
+                }
+                this->shift = 16 - this->shift;
+            } else {
+                // As many bins per power of two as fit in one half
+                while (((uint32_t)(16 - (this->shift + 1)) << (this->shift + 1)) <= Bins / 2) {
+                    this->shift++;
+                }
+            }
+            reset();
+        }
+
+        /*  Get the bin of a raw value
+
+            @param raw - the raw pressure value
+            @returns the bin index, bins are in increasing order of value
+        */
+        uint16_t bin(int16_t raw) {
+            if (this->layout == LinearBins) {
+                return (uint16_t)(raw + 32768) >> this->shift;
+            }
+            // ~raw is -raw - 1, which keeps -32768 in range
+            if (raw < 0) {
+                return Bins / 2 - 1 - logIndex((uint16_t)~raw);
+            }
+            return Bins / 2 + logIndex((uint16_t)raw);
+        }
+
+        /*  Get the lowest raw value that falls into a bin
+
+            Bins that no raw value maps to, at both ends of a LogBins layout, give -32768 below
+            the lowest used bin and 32768 above the highest one.
+            @param bin - the bin index, Bins for the upper edge of the last bin
+            @returns the raw pressure value, -32768 - 32768
+        */
+        int32_t lowerBound(uint16_t bin) {
+            if (this->layout == LinearBins) {
+                return (int32_t)((uint32_t)bin << this->shift) - 32768;
+            }
+            if (bin < Bins / 2) {
+                // The lowest value is the largest magnitude, just below the next index
+                return -(int32_t)logMagnitude(Bins / 2 - bin);
+            }
+            return (int32_t)logMagnitude(bin - Bins / 2);
+        }
+
+        /*  Count a raw value
+
+            @param raw - the raw pressure value
+        */
+        void add(int16_t raw) {
+            Counter *count = &this->counts[bin(raw)];
+            if (*count != (Counter)~(Counter)0) {
+                (*count)++;
+            }
+        }
+
+        /*  Add the counts of another histogram to this one
+
+            @param other - a histogram of the same type
+            @returns true, iff both use the same layout and were merged
+        */
+        bool merge(const SDPHistogram &other) {
+            if (other.layout != this->layout) {
+                return false;
+            }
+            merge(other.counts);
+            return true;
+        }
+
+        /*  Add exported counts to this histogram, eg. a chunk saved with data()
+
+            @param counts - Bins counters of a histogram with the same layout, lowest bin first
+        */
+        void merge(const Counter *counts) {
+            uint16_t i;
+            Counter sum;
+            for (i = 0; i < Bins; i++) {
+                sum = this->counts[i] + counts[i];
+                // Saturate on overflow
+                this->counts[i] = (sum < this->counts[i]) ? (Counter)~(Counter)0 : sum;
+            }
+        }
+
+        /*  Get the count of a bin
+
+            @param bin - the bin index
+            @returns the number of values counted, saturated at the Counter maximum
+        */
+        Counter count(uint16_t bin) {
+            return this->counts[bin];
+        }
+
+        /*  Get the number of values counted
+
+            @returns the sum of all bins
+        */
+        uint64_t total() {
+            uint64_t sum = 0;
+            uint16_t i;
+            for (i = 0; i < Bins; i++) {
+                sum += this->counts[i];
+            }
+            return sum;
+        }
+
+        /*  Estimate a quantile of the values counted
+
+            The bin holding the requested rank is found by walking the counts, and the value is
+            interpolated within it, so the error is at most one bin width. Saturated bins make the
+            result meaningless.
+            @param permille - the quantile in 1/1000 (eg. 500 for the median, 990 for p99)
+            @returns the raw pressure value, 0 iff nothing was counted
+        */
+        int16_t quantile(uint16_t permille) {
+            uint64_t rank, below = 0;
+            int32_t  lower, upper;
+            uint16_t i;
+            if (permille > 1000) {
+                permille = 1000;
+            }
+            // Rank of the value, 1 for the smallest
+            rank = (total() * permille + 999) / 1000;
+            if (rank == 0) {
+                rank = 1;
+            }
+            for (i = 0; i < Bins; i++) {
+                if (below + this->counts[i] >= rank) {
+                    lower = lowerBound(i);
+                    upper = lowerBound(i + 1);
+                    // Place the value as if the bin's samples were spread evenly over it
+                    return (int16_t)(lower + (int32_t)((upper - lower) * (rank - below - 1) /
+                                                       this->counts[i]));
+                }
+                below += this->counts[i];
+            }
+            return 0;
+        }
+
+        /*  Get all counts, eg. to export them
+
+            @returns Bins counters, lowest bin first
+        */
+        const Counter *data() {
+            return this->counts;
+        }
+
+        /* Clear all counts */
+        void reset() {
+            uint16_t i;
+            for (i = 0; i < Bins; i++) {
+                this->counts[i] = 0;
+            }
+        }
+};
+
+#endif
@@ -0,0 +1,217 @@
+/*
+    SDPModbus.cpp - Modbus RTU server for cached SDP sensor readings.
+
+    Copyright (c) 2026 SDP3x-Arduino contributors
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SDPModbus.h"
+
+/*  Constructor
+
+    @param port  - the serial port, already started at "baud"
+    @param unit  - the Modbus address, 1 - 247
+    @param baud  - the baud rate, used for frame timing
+    @param dePin - the RS-485 driver enable pin, -1 if the transceiver switches itself
+    @returns a new SDPModbus as configured
+*/
+SDPModbus::SDPModbus(Stream &port, const uint8_t unit, const uint32_t baud, const int8_t dePin) {
+    uint8_t i;
+    this->port  = &port;
+    this->unit  = unit;
+    this->dePin = dePin;
+    // 3.5 characters of 11 bits, fixed at 1750us above 19200 baud as the spec says
+    this->silence    = (baud > 19200) ? 1750 : 38500000UL / baud;
+    this->length     = 0;
+    this->crc        = 0xFFFF;
+    this->lastByte   = 0;
+    this->lastSample = 0;
+    this->sampled    = false;
+    for (i = 0; i < ModbusRegisters; i++) {
+        this->registers[i] = 0;
+    }
+}
+
+/* Set up the driver enable pin, call once from setup() */
+void SDPModbus::begin() {
+    if (this->dePin >= 0) {
+        pinMode(this->dePin, OUTPUT);
+        digitalWrite(this->dePin, LOW);
+    }
+}
+
+/*  Read the sensor and update the cached registers
+
+    @param sensor - a sensor in continuous mode
+    @returns true, iff the read succeeded
+*/
+bool SDPModbus::refresh(SDPSensor &sensor) {
+    int16_t pressure = 0;
+    int16_t temp     = 0;
+    uint8_t scale;
+    if (!sensor.readMeasurement(&pressure, &temp, NULL)) {
+        this->registers[ModbusErrors]++;
+        return false;
+    }
+    scale = sensor.getPressureScale();
+    this->registers[ModbusPressureRaw]    = (uint16_t)pressure;
+    this->registers[ModbusTemperatureRaw] = (uint16_t)temp;
+    this->registers[ModbusPressureScale]  = scale;
+    if (scale != 0) {
+        this->registers[ModbusPressure] = (uint16_t)(int16_t)((int32_t)pressure * 10 / scale);
+    }
+    this->registers[ModbusTemperature] =
+        (uint16_t)(int16_t)((int32_t)temp * 100 / SDP3X_TempScale);
+    this->registers[ModbusReads]++;
+    this->lastSample = millis();
+    this->sampled = true;
+    return true;
+}
+
+/*  Receive requests and answer complete ones, call as often as possible
+
+    @returns true, iff a reply was sent
+*/
+bool SDPModbus::poll() {
+    bool replied = false;
+    // Bytes still waiting belong to the next frame, so finish the current one first
+    if ((this->length > 0) && ((uint32_t)(micros() - this->lastByte) >= this->silence)) {
+        replied = this->handle();
+        this->length = 0;
+        this->crc    = 0xFFFF;
+    }
+    while (this->port->available() > 0) {
+        uint8_t b = (uint8_t)this->port->read();
+        if (this->length < sizeof(this->frame)) {
+            this->frame[this->length] = b;
+        }
+        // Only the start of longer requests is kept, the CRC covers all of it
+        this->crc = crc16Update(this->crc, b);
+        if (this->length < 0xFFFF) {
+            this->length++;
+        }
+        this->lastByte = micros();
+    }
+    return replied;
+}
+
+/*  Handle a complete request frame
+
+    Read Request Format:
+    | Byte  | 0    | 1        | 2 3   | 4 5   | 6 7 |
+    | Value | unit | function | start | count | crc |
+
+    @returns true, iff a reply was sent
+*/
+bool SDPModbus::handle() {
+    uint8_t reply[5 + 2 * ModbusRegisters];
+    uint16_t start, count, age, i;
+    // The CRC of a frame including its own CRC is 0; frames are 4 to 256 bytes
+    if ((this->length < 4) || (this->length > 256) || (this->crc != 0)) {
+        return false;
+    }
+    // Not for us, or a broadcast that reads cannot answer
+    if (this->frame[0] != this->unit) {
+        return false;
+    }
+    reply[0] = this->unit;
+    reply[1] = this->frame[1];
+    if ((this->frame[1] != 0x03) && (this->frame[1] != 0x04)) {
+        reply[1] |= 0x80;
+        reply[2] = 0x01;  // Illegal Function
+        this->send(reply, 3);
+        return true;
+    }
+    start = ((uint16_t)this->frame[2] << 8) | this->frame[3];
+    count = ((uint16_t)this->frame[4] << 8) | this->frame[5];
+    if ((this->length != sizeof(this->frame)) || (count == 0) || (count > 125)) {
+        reply[1] |= 0x80;
+        reply[2] = 0x03;  // Illegal Data Value
+        this->send(reply, 3);
+        return true;
+    }
+    if (((uint32_t)start + count) > ModbusRegisters) {
+        reply[1] |= 0x80;
+        reply[2] = 0x02;  // Illegal Data Address
+        this->send(reply, 3);
+        return true;
+    }
+    if (this->sampled && ((uint32_t)(millis() - this->lastSample) < 65535UL)) {
+        age = (uint16_t)(millis() - this->lastSample);
+    } else {
+        age = 65535;
+    }
+    this->registers[ModbusAge] = age;
+    reply[2] = (uint8_t)(2 * count);
+    for (i = 0; i < count; i++) {
+        reply[3 + 2 * i] = (uint8_t)(this->registers[start + i] >> 8);
+        reply[4 + 2 * i] = (uint8_t)this->registers[start + i];
+    }
+    this->send(reply, 3 + 2 * count);
+    return true;
+}
+
+/*  Append a CRC and send a reply
+
+    @param reply  - the reply, with 2 spare bytes at the end for the CRC
+    @param length - the length of the reply without the CRC
+*/
+void SDPModbus::send(uint8_t *reply, uint8_t length) {
+    uint16_t crc = crc16(reply, length);
+    reply[length]     = (uint8_t)crc;
+    reply[length + 1] = (uint8_t)(crc >> 8);
+    if (this->dePin >= 0) {
+        digitalWrite(this->dePin, HIGH);
+    }
+    this->port->write(reply, length + 2);
+    if (this->dePin >= 0) {
+        // Release the line only once the last byte is out
+        this->port->flush();
+        digitalWrite(this->dePin, LOW);
+    }
+}
+
+/*  Compute the Modbus CRC-16 of a sequence of bytes
+
+    @param data - the bytes to checksum
+    @param len  - the number of bytes in data
+    @returns the CRC-16, sent low byte first
+*/
+uint16_t SDPModbus::crc16(const uint8_t *data, uint8_t len) {
+    uint16_t crc = 0xFFFF;
+    uint8_t i;
+    for (i = 0; i < len; i++) {
+        crc = crc16Update(crc, data[i]);
+    }
+    return crc;
+}
+
+/*  Feed one byte to a Modbus CRC-16
+
+    @param crc - the CRC so far, 0xFFFF to start
+    @param b   - the byte
+    @returns the updated CRC
+*/
+uint16_t SDPModbus::crc16Update(uint16_t crc, uint8_t b) {
+    uint8_t bit;
+    crc ^= b;
+    for (bit = 0; bit < 8; bit++) {
+        // Reflected polynomial 0x8005
+        crc = (crc & 1) ? (crc >> 1) ^ 0xA001 : crc >> 1;
+    }
+    return crc;
+}
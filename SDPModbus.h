@@ -0,0 +1,137 @@
+/*
+    SDPModbus.h - Modbus RTU server for cached SDP sensor readings.
+
+    Copyright (c) 2026 SDP3x-Arduino contributors
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef SDPMODBUS_H
+#define SDPMODBUS_H
+
+#include "Arduino.h"
+#include "SDPSensors.h"
+
+/*  Register map, served to both Read Holding Registers (0x03) and Read Input Registers (0x04)
+
+    ModbusPressureRaw    - raw pressure, int16
+    ModbusTemperatureRaw - raw temperature, int16
+    ModbusPressureScale  - pressure scale, in units of 1/Pa
+    ModbusPressure       - pressure, int16 in 0.1 Pa
+    ModbusTemperature    - temperature, int16 in 0.01 C
+    ModbusReads          - successful sensor reads, wrapping
+    ModbusErrors         - failed sensor reads, wrapping
+    ModbusAge            - time since the last successful read in ms, 65535 if none or older
+*/
+const uint8_t ModbusPressureRaw    = 0;
+const uint8_t ModbusTemperatureRaw = 1;
+const uint8_t ModbusPressureScale  = 2;
+const uint8_t ModbusPressure       = 3;
+const uint8_t ModbusTemperature    = 4;
+const uint8_t ModbusReads          = 5;
+const uint8_t ModbusErrors         = 6;
+const uint8_t ModbusAge            = 7;
+const uint8_t ModbusRegisters      = 8;
+
+/*  The SDPModbus class answers Modbus RTU polls from cached sensor values
+
+    refresh() does the I2C reads and poll() only answers from the cache, so the reply time does
+    not depend on the sensor or the bus: it is a copy of at most ModbusRegisters registers and a
+    CRC, sent as soon as the request frame is over. Only reads (0x03 and 0x04) are supported,
+    any other request addressed to this unit gets an Illegal Function exception.
+*/
+class SDPModbus {
+    private:
+        /* Serial port of the RS-485 line */
+        Stream *port;
+        /* Cached registers */
+        uint16_t registers[ModbusRegisters];
+        /* Start of the request being received, all a read request needs */
+        uint8_t frame[8];
+        /* Length of the request so far, and its running CRC */
+        uint16_t length;
+        uint16_t crc;
+        /* Time of the last byte received, micros() */
+        uint32_t lastByte;
+        /* Silence that ends a frame (3.5 characters), in microseconds */
+        uint32_t silence;
+        /* Time of the last successful read, millis() */
+        uint32_t lastSample;
+        /* Modbus address of this server */
+        uint8_t unit;
+        /* RS-485 driver enable pin, -1 if none */
+        int8_t dePin;
+        /* true once a read succeeded */
+        bool sampled;
+
+        /*  Handle a complete request frame
+
+            @returns true, iff a reply was sent
+        */
+        bool handle();
+
+        /*  Append a CRC and send a reply
+
+            @param reply  - the reply, with 2 spare bytes at the end for the CRC
+            @param length - the length of the reply without the CRC
+        */
+        void send(uint8_t *reply, uint8_t length);
+
+    public:
+        /*  Constructor
+
+            @param port  - the serial port, already started at "baud"
+            @param unit  - the Modbus address, 1 - 247
+            @param baud  - the baud rate, used for frame timing
+            @param dePin - the RS-485 driver enable pin, -1 if the transceiver switches itself
+            @returns a new SDPModbus as configured
+        */
+        SDPModbus(Stream &port, const uint8_t unit, const uint32_t baud, const int8_t dePin = -1);
+
+        /* Set up the driver enable pin, call once from setup() */
+        void begin();
+
+        /*  Read the sensor and update the cached registers
+
+            @param sensor - a sensor in continuous mode
+            @returns true, iff the read succeeded
+        */
+        bool refresh(SDPSensor &sensor);
+
+        /*  Receive requests and answer complete ones, call as often as possible
+
+            @returns true, iff a reply was sent
+        */
+        bool poll();
+
+        /*  Compute the Modbus CRC-16 of a sequence of bytes
+
+            @param data - the bytes to checksum
+            @param len  - the number of bytes in data
+            @returns the CRC-16, sent low byte first
+        */
+        static uint16_t crc16(const uint8_t *data, uint8_t len);
+
+        /*  Feed one byte to a Modbus CRC-16
+
+            @param crc - the CRC so far, 0xFFFF to start
+            @param b   - the byte
+            @returns the updated CRC
+        */
+        static uint16_t crc16Update(uint16_t crc, uint8_t b);
+};
+
+#endif
@@ -0,0 +1,117 @@
+/*
+    SDPNoiseBudget.cpp - Choosing averaging mode and read rate of SDP sensors from measured noise.
+
+    Copyright (c) 2026 SDP3x-Arduino contributors
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SDPNoiseBudget.h"
+
+/* Read intervals tried by autoConfigure(), in ms, longest first */
+static const uint16_t Intervals[] = { 500, 200, 100, 50, 20, 10, 5, 2, 1 };
+
+/*  Measure the noise of a sensor in one configuration
+
+    @param sensor    - the sensor to measure
+    @param averaging - use on-chip averaging
+    @param interval  - the time between two reads in ms
+    @param duration  - how long to measure in ms
+    @returns the noise in raw counts, or a negative value iff the sensor could not be read
+*/
+float measureNoise(SDPSensor &sensor, bool averaging, uint16_t interval, uint16_t duration) {
+    int16_t pressure, previous = 0;
+    int32_t diff;
+    int64_t sum = 0, squares = 0;
+    uint32_t start, n = 0;
+    bool first = true;
+    float mean;
+    // A measuring sensor only accepts Stop, so stop it before switching modes
+    sensor.stopContinuous();
+    if (!sensor.startContinuous(averaging)) {
+        return -1;
+    }
+    // Drop what was averaged while switching modes
+    delay(interval);
+    sensor.readMeasurement(&pressure, NULL, NULL);
+    start = millis();
+    while (millis() - start < duration) {
+        delay(interval);
+        if (!sensor.readMeasurement(&pressure, NULL, NULL)) {
+            continue;
+        }
+        if (!first) {
+            diff = (int32_t)pressure - previous;
+            sum += diff;
+            squares += (int64_t)diff * diff;
+            n++;
+        }
+        previous = pressure;
+        first    = false;
+    }
+    if (n < 2) {
+        return -1;
+    }
+    // The difference of two independent readings has twice the variance of one
+    mean = (float)sum / n;
+    return sqrt(((float)squares / n - mean * mean) / 2);
+}
+
+/*  Pick and apply the configuration with the lowest bus load that meets a noise target
+
+    @param sensor      - the sensor to configure
+    @param targetNoise - the highest acceptable noise in raw counts
+    @param maxInterval - the longest acceptable time between two reads (latency) in ms
+    @param chosen      - a pointer to store the configuration that was applied
+    @param duration    - how long to measure each configuration in ms
+    @returns true, iff the target was met and applied, otherwise the quietest configuration is
+             applied if possible
+*/
+bool autoConfigure(SDPSensor &sensor, float targetNoise, uint16_t maxInterval, NoiseConfig *chosen,
+                   uint16_t duration) {
+    NoiseConfig best;
+    uint8_t i, mode;
+    bool averaging;
+    float noise;
+    best.noise = -1;
+    for (i = 0; i < sizeof(Intervals) / sizeof(Intervals[0]); i++) {
+        if (Intervals[i] > maxInterval) {
+            continue;
+        }
+        // Both modes cost the same bus time at a given interval, keep the quieter one
+        for (mode = 0; mode < 2; mode++) {
+            averaging = (mode == 0);
+            noise     = measureNoise(sensor, averaging, Intervals[i], duration);
+            if ((noise >= 0) && ((best.noise < 0) || (noise < best.noise))) {
+                best.averaging = averaging;
+                best.interval  = Intervals[i];
+                best.noise     = noise;
+            }
+        }
+        if ((best.noise >= 0) && (best.noise <= targetNoise)) {
+            break;
+        }
+    }
+    if (best.noise < 0) {
+        return false;
+    }
+    *chosen = best;
+    sensor.stopContinuous();
+    if (!sensor.startContinuous(best.averaging)) {
+        return false;
+    }
+    return best.noise <= targetNoise;
+}
@@ -0,0 +1,69 @@
+/*
+    SDPNoiseBudget.h - Choosing averaging mode and read rate of SDP sensors from measured noise.
+
+    Copyright (c) 2026 SDP3x-Arduino contributors
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef SDPNOISEBUDGET_H
+#define SDPNOISEBUDGET_H
+
+#include "Arduino.h"
+#include "SDPSensors.h"
+
+/* A sampling configuration and the noise measured with it */
+typedef struct {
+    /* Continuous mode with on-chip averaging */
+    bool averaging;
+    /* Time between two reads in ms */
+    uint16_t interval;
+    /* Noise in raw counts (standard deviation) */
+    float noise;
+} NoiseConfig;
+
+/*  Measure the noise of a sensor in one configuration
+
+    The sensor is stopped, put in continuous mode and read every "interval" ms for "duration" ms.
+    Noise is taken from the differences of consecutive readings, so a slowly moving pressure does
+    not count as noise. Blocks for "duration" ms.
+    @param sensor    - the sensor to measure
+    @param averaging - use on-chip averaging
+    @param interval  - the time between two reads in ms
+    @param duration  - how long to measure in ms
+    @returns the noise in raw counts, or a negative value iff the sensor could not be read
+*/
+float measureNoise(SDPSensor &sensor, bool averaging, uint16_t interval, uint16_t duration);
+
+/*  Pick and apply the configuration with the lowest bus load that meets a noise target
+
+    Read intervals up to "maxInterval" are tried from the longest (lowest bus load) down, in both
+    modes, and the search stops at the first one that meets the target. That takes 2 * "duration"
+    when the longest interval already meets it, and at most 18 * "duration" when none does.
+    The sensor is left in continuous mode with the chosen averaging setting, to be read every
+    "chosen->interval" ms.
+    @param sensor      - the sensor to configure
+    @param targetNoise - the highest acceptable noise in raw counts
+    @param maxInterval - the longest acceptable time between two reads (latency) in ms
+    @param chosen      - a pointer to store the configuration that was applied
+    @param duration    - how long to measure each configuration in ms
+    @returns true, iff the target was met and applied, otherwise the quietest configuration is
+             applied if possible
+*/
+bool autoConfigure(SDPSensor &sensor, float targetNoise, uint16_t maxInterval, NoiseConfig *chosen,
+                   uint16_t duration = 2000);
+
+#endif
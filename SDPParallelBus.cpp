@@ -0,0 +1,164 @@
+/*
+    SDPParallelBus.cpp - Bit-banged I2C reading many same-address SDP sensors at once.
+
+    Copyright (c) 2026 SDP3x-Arduino contributors
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SDPParallelBus.h"
+#include "SDPSensors.h"
+
+/*  Constructor
+
+    @param port  - the pins to drive
+    @param lanes - the number of SDA lines, at most 32
+    @returns a new SDPParallelBus as configured
+*/
+SDPParallelBus::SDPParallelBus(SDPGpioPort &port, uint8_t lanes) {
+    this->port  = &port;
+    this->lanes = (lanes >= 32) ? 0xFFFFFFFF : (((uint32_t)1 << lanes) - 1);
+}
+
+/* Send a START condition */
+void SDPParallelBus::start() {
+    this->port->sda(0);
+    this->port->scl(true);
+    this->port->wait();
+    this->port->sda(this->lanes);
+    this->port->wait();
+    this->port->scl(false);
+}
+
+/* Send a STOP condition */
+void SDPParallelBus::stop() {
+    this->port->sda(this->lanes);
+    this->port->wait();
+    this->port->scl(true);
+    this->port->wait();
+    this->port->sda(0);
+    this->port->wait();
+}
+
+/*  Write one byte to all lanes
+
+    @returns a mask of lanes that acknowledged it
+*/
+uint32_t SDPParallelBus::writeByte(uint8_t value) {
+    uint8_t bit;
+    uint32_t nack;
+    for (bit = 0x80; bit > 0; bit >>= 1) {
+        this->port->sda((value & bit) ? 0 : this->lanes);
+        this->port->wait();
+        this->port->scl(true);
+        this->port->wait();
+        this->port->scl(false);
+    }
+    // Release SDA, each sensor pulls its own line low to acknowledge
+    this->port->sda(0);
+    this->port->wait();
+    this->port->scl(true);
+    this->port->wait();
+    nack = this->port->read();
+    this->port->scl(false);
+    return ~nack & this->lanes;
+}
+
+/*  Read one byte from all lanes
+
+    @param samples - a buffer to store the 8 port samples, MSB first
+    @param ack     - acknowledge the byte, false for the last byte of a read
+*/
+void SDPParallelBus::readByte(uint32_t samples[8], bool ack) {
+    uint8_t bit;
+    this->port->sda(0);
+    for (bit = 0; bit < 8; bit++) {
+        this->port->wait();
+        this->port->scl(true);
+        this->port->wait();
+        // One port read samples this bit of every lane
+        samples[bit] = this->port->read();
+        this->port->scl(false);
+    }
+    this->port->sda(ack ? this->lanes : 0);
+    this->port->wait();
+    this->port->scl(true);
+    this->port->wait();
+    this->port->scl(false);
+}
+
+/*  Send a write command to all lanes
+
+    @param addr - the I2C address shared by all sensors
+    @param cmd  - the two byte command to send
+    @returns a mask of lanes where all ACKs were received
+*/
+uint32_t SDPParallelBus::writeCommand(uint8_t addr, const uint8_t cmd[2]) {
+    uint32_t acked;
+    start();
+    acked = writeByte(addr << 1);
+    acked &= writeByte(cmd[0]);
+    acked &= writeByte(cmd[1]);
+    stop();
+    return acked;
+}
+
+/*  Read data back from all lanes
+
+    @param addr   - the I2C address shared by all sensors
+    @param words  - the number of words to read, at most MaxReadWords
+    @param frames - a buffer of lanes * words * 3 bytes
+    @returns a mask of lanes where the address was acknowledged and all CRCs passed
+*/
+uint32_t SDPParallelBus::readData(uint8_t addr, uint8_t words, uint8_t *frames) {
+    uint32_t samples[8];
+    uint32_t crc[8];
+    uint32_t success;
+    uint8_t len = words * 3;
+    uint8_t i, bit, lane, value, pos;
+    if (words > MaxReadWords) {
+        return 0;
+    }
+    start();
+    success = writeByte((addr << 1) | 1);
+    for (i = 0, pos = 0; i < len; i++) {
+        readByte(samples, i + 1 < len);
+        // The samples already are bit planes, so the CRC of every lane is checked at once
+        if (pos == 0) {
+            sdp_crc8_sliced_init(crc, this->lanes);
+        }
+        if (pos == 2) {
+            success &= sdp_crc8_sliced_match(crc, samples);
+            pos = 0;
+        } else {
+            sdp_crc8_sliced_update(crc, samples);
+            pos++;
+        }
+        // Demultiplex: bit "lane" of each sample belongs to that lane's byte
+        for (lane = 0; lane < 32; lane++) {
+            if (!(this->lanes & ((uint32_t)1 << lane))) {
+                break;
+            }
+            value = 0;
+            for (bit = 0; bit < 8; bit++) {
+                value = (value << 1) | ((samples[bit] >> lane) & 1);
+            }
+            frames[lane * len + i] = value;
+        }
+    }
+    stop();
+    return success;
+}
@@ -0,0 +1,118 @@
+/*
+    SDPParallelBus.h - Bit-banged I2C reading many same-address SDP sensors at once.
+
+    Copyright (c) 2026 SDP3x-Arduino contributors
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef SDPPARALLELBUS_H
+#define SDPPARALLELBUS_H
+
+#include "Arduino.h"
+#include "SDPCodec.h"
+
+/*  The SDPGpioPort class is the interface SDPParallelBus uses to drive the pins
+
+    All lanes share one SCL line and each lane has its own SDA line. Lane n is bit n of the masks,
+    so an implementation on a single GPIO port is a shift and a register access per call.
+*/
+class SDPGpioPort {
+    public:
+        /*  Drive SCL
+
+            @param high - release SCL (pulled high) if true, drive it low otherwise
+        */
+        virtual void scl(bool high) = 0;
+
+        /*  Drive the SDA lines
+
+            @param low - a mask of lanes to drive low, all other lanes are released
+        */
+        virtual void sda(uint32_t low) = 0;
+
+        /*  Sample all SDA lines at once
+
+            @returns a mask of lanes that read high
+        */
+        virtual uint32_t read() = 0;
+
+        /* Wait for half an SCL period */
+        virtual void wait() = 0;
+};
+
+/*  The SDPParallelBus class talks to many sensors with the same address at once
+
+    Every lane gets the same bytes written, and one port read per clock samples the bit of every
+    lane. Clock stretching is not supported, so use the non-stretching trigger commands.
+*/
+class SDPParallelBus {
+    private:
+        /* The pins of this bus */
+        SDPGpioPort *port;
+        /* A mask of the lanes in use */
+        uint32_t lanes;
+
+        /* Send a START condition */
+        void start();
+
+        /* Send a STOP condition */
+        void stop();
+
+        /*  Write one byte to all lanes
+
+            @returns a mask of lanes that acknowledged it
+        */
+        uint32_t writeByte(uint8_t value);
+
+        /*  Read one byte from all lanes
+
+            @param samples - a buffer to store the 8 port samples, MSB first
+            @param ack     - acknowledge the byte, false for the last byte of a read
+        */
+        void readByte(uint32_t samples[8], bool ack);
+
+    public:
+        /*  Constructor
+
+            @param port  - the pins to drive
+            @param lanes - the number of SDA lines, at most 32
+            @returns a new SDPParallelBus as configured
+        */
+        SDPParallelBus(SDPGpioPort &port, uint8_t lanes);
+
+        /*  Send a write command to all lanes
+
+            @param addr - the I2C address shared by all sensors
+            @param cmd  - the two byte command to send
+            @returns a mask of lanes where all ACKs were received
+        */
+        uint32_t writeCommand(uint8_t addr, const uint8_t cmd[2]);
+
+        /*  Read data back from all lanes
+
+            CRCs are checked for all lanes at once with the bit-sliced CRC. Frames are stored lane
+            after lane, each one "words" * 3 bytes long with the CRC bytes kept, ready for
+            sdp_decode_words().
+            @param addr   - the I2C address shared by all sensors
+            @param words  - the number of words to read, at most MaxReadWords
+            @param frames - a buffer of lanes * words * 3 bytes
+            @returns a mask of lanes where the address was acknowledged and all CRCs passed
+        */
+        uint32_t readData(uint8_t addr, uint8_t words, uint8_t *frames);
+};
+
+#endif
@@ -0,0 +1,93 @@
+/*
+    SDPScheduler.cpp - Stretch-free triggered measurements across many SDP sensors.
+
+    Copyright (c) 2026 SDP3x-Arduino contributors
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SDPScheduler.h"
+
+/*  Constructor
+
+    @returns a new SDPScheduler with no sensors
+*/
+SDPScheduler::SDPScheduler() {
+    this->pending = 0;
+    this->retried = 0;
+    this->count   = 0;
+    this->cursor  = 0;
+}
+
+/*  Add a sensor, which must not be in continuous mode
+
+    @param sensor - the sensor to drive
+    @param period - the time between two measurements in ms, at least TriggerConversionTime
+    @returns true, iff there was room for the sensor
+*/
+bool SDPScheduler::add(SDPSensor &sensor, uint32_t period) {
+    if (this->count == SDP_SCHEDULER_MAX) {
+        return false;
+    }
+    this->sensors[this->count] = &sensor;
+    this->periods[this->count] = period;
+    this->due[this->count]     = millis();
+    this->count++;
+    return true;
+}
+
+/*  Do the next bus transaction that is due, if any
+
+    @param pressure - a pointer to store the raw pressure value
+    @returns the index of the sensor "pressure" was read from, or -1 if none was read
+*/
+int8_t SDPScheduler::poll(int16_t *pressure) {
+    uint32_t now = millis();
+    uint32_t bit;
+    uint8_t i, n;
+    bool success;
+    for (n = 0; n < this->count; n++) {
+        i            = this->cursor;
+        bit          = (uint32_t)1 << i;
+        this->cursor = (i + 1 == this->count) ? 0 : i + 1;
+        if (this->pending & bit) {
+            if (!this->sensors[i]->measurementReady()) {
+                continue;
+            }
+            success = this->sensors[i]->readMeasurement(pressure, NULL, NULL);
+            // A NACK right at the end of the conversion gets one more try on a later poll()
+            if (!success && !(this->retried & bit)) {
+                this->retried |= bit;
+                return -1;
+            }
+            this->pending &= ~bit;
+            this->retried &= ~bit;
+            return success ? (int8_t)i : -1;
+        }
+        if ((int32_t)(now - this->due[i]) >= 0) {
+            // Keep the rate steady, but do not try to catch up on missed periods
+            this->due[i] += this->periods[i];
+            if ((int32_t)(now - this->due[i]) >= 0) {
+                this->due[i] = now + this->periods[i];
+            }
+            if (this->sensors[i]->triggerMeasurement(false)) {
+                this->pending |= bit;
+            }
+            return -1;
+        }
+    }
+    return -1;
+}
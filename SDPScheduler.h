@@ -0,0 +1,83 @@
+/*
+    SDPScheduler.h - Stretch-free triggered measurements across many SDP sensors.
+
+    Copyright (c) 2026 SDP3x-Arduino contributors
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef SDPSCHEDULER_H
+#define SDPSCHEDULER_H
+
+#include "Arduino.h"
+#include "SDPSensors.h"
+
+/*  The number of sensors one SDPScheduler can drive
+
+    Define it before including this file to change it, up to 32.
+*/
+#ifndef SDP_SCHEDULER_MAX
+#define SDP_SCHEDULER_MAX 8
+#endif
+
+/*  The SDPScheduler class runs triggered measurements on many sensors without clock stretching
+
+    Stretching triggers hold SCL low for the whole conversion, which blocks every other device on
+    the bus. The scheduler only sends non-stretching triggers and reads each sensor once its
+    conversion is done. Every call to poll() does at most one bus transaction, so other sensors
+    and devices are served while conversions run.
+*/
+class SDPScheduler {
+    private:
+        /* The sensors to drive */
+        SDPSensor *sensors[SDP_SCHEDULER_MAX];
+        /* Time between two triggers of each sensor, in ms */
+        uint32_t periods[SDP_SCHEDULER_MAX];
+        /* When each sensor is due to be triggered next */
+        uint32_t due[SDP_SCHEDULER_MAX];
+        /* A mask of sensors with a conversion running */
+        uint32_t pending;
+        /* A mask of pending sensors whose first read was NACKed */
+        uint32_t retried;
+        /* Number of sensors in use */
+        uint8_t count;
+        /* Sensor to look at first on the next poll(), for fairness */
+        uint8_t cursor;
+
+    public:
+        /*  Constructor
+
+            @returns a new SDPScheduler with no sensors
+        */
+        SDPScheduler();
+
+        /*  Add a sensor, which must not be in continuous mode
+
+            @param sensor - the sensor to drive
+            @param period - the time between two measurements in ms, at least TriggerConversionTime
+            @returns true, iff there was room for the sensor
+        */
+        bool add(SDPSensor &sensor, uint32_t period);
+
+        /*  Do the next bus transaction that is due, if any
+
+            @param pressure - a pointer to store the raw pressure value
+            @returns the index of the sensor "pressure" was read from, or -1 if none was read
+        */
+        int8_t poll(int16_t *pressure);
+};
+
+#endif
@@ -23,6 +23,15 @@
 
 #include "SDPSensors.h"
 
+/*  Compute the CRC-8 of a sequence of bytes
+
+    @param data - the bytes to checksum
+    @param len  - the number of bytes in data
+    @returns the CRC-8 of data
+*/
+uint8_t SDPSensor::crc8(const uint8_t *data, uint8_t len) {
+    return sdp_crc8(data, len);
+}
 
 /*  Send a write command
 
@@ -40,17 +49,24 @@ bool SDPSensor::writeCommand(const uint8_t cmd[2]) {
 
 /*  Read data back from the device
 
-    @param words - the number of words to read
+    @param words - the number of words to read, at most MaxReadWords
     @returns true iff all words read and CRC passed
 */
 bool SDPSensor::readData(uint8_t words) {
     size_t read;
     uint8_t crc = 0xFF;
+    uint8_t pos;
+    uint8_t b;
     uint8_t *next;
     bool success = true;
-    // Clear buffer
-    for (next = &this->buffer[12]; next > this->buffer; next--) {
-        *next = 0;
+    // Keep the worst case bounded by the buffer size, whatever the caller asks for: at most
+    // MaxReadWords * 3 bytes are read and only the MaxReadWords * 2 data bytes are stored
+    if (words > MaxReadWords) {
+        return false;
+    }
+    // Clear only the part of the buffer this read will fill
+    for (next = &this->buffer[words * 2]; next > this->buffer;) {
+        *--next = 0;
     }
     // Each word is two bytes plus a CRC byte, ergo 3 bytes per word
     read = this->port->requestFrom(this->addr, (uint8_t)(words * 3));
@@ -61,25 +77,33 @@ bool SDPSensor::readData(uint8_t words) {
     if (read != 3 * words) {
         success = false;
     }
+    // A misbehaving bus driver must not make us read past the buffer
+    if (read > 3 * words) {
+        read = 3 * words;
+    }
     /*  Calculate CRC while reading bytes
 
         Adapted from:
         http://www.sunshine2k.de/articles/coding/crc/understanding_crc.html
     */
     next = this->buffer;
+    // Position in the current word, counted rather than "read % 3" to avoid a division per byte
+    pos = 0;
     for (; read > 0; read--) {
-        // Read next available byte
-        *next = this->port->read();
+        // Read next available byte, CRC bytes are not stored
+        b = this->port->read();
         // Every third byte
-        if ((read % 3) == 1) {
+        if (pos == 2) {
             // Check CRC byte
-            success = success && (crc == *next);
+            success = success && (crc == b);
             crc     = 0xFF;
+            pos     = 0;
         } else {
             // Update CRC
-            crc = CRC_LUT[crc ^ *next];
-            // Go to next byte
-            next++;
+            crc = SDP_CRC_LUT[crc ^ b];
+            // Store and go to next byte
+            *next++ = b;
+            pos++;
         }
     }
     return success;
@@ -92,9 +116,14 @@ bool SDPSensor::readData(uint8_t words) {
     @returns a new SDP3X as configured
 */
 SDPSensor::SDPSensor(const uint8_t addr, const TempCompensation comp, TwoWire &wirePort) {
-    this->port = &wirePort;
-    this->comp = comp;
-    this->addr = addr;
+    this->port        = &wirePort;
+    this->comp        = comp;
+    this->addr        = addr;
+    // Not known until begin() identifies the sensor, a scale of 0 marks that
+    this->number      = SDP31_500;
+    this->scale       = 0;
+    this->mode        = Stopped;
+    this->triggeredAt = 0;
 }
 
 /*  Finish Initializing the sensor object
@@ -151,6 +180,63 @@ PressureRange SDPSensor::begin() {
     }
 }
 
+/*  Resume from a snapshot taken before a reset
+
+    @param snapshot - the state saved by saveState()
+    @returns sensor pressure range, iff everything went correctly or SDP_NA iff not found
+*/
+PressureRange SDPSensor::begin(const SDPSnapshot *snapshot) {
+    /* Product ID of each Model, in enum order */
+    static const uint32_t ModelPID[] = { SPD31_500_PID,  SDP32_125_PID,  SDP800_500_PID,
+                                         SDP810_500_PID, SDP801_500_PID, SDP811_500_PID,
+                                         SDP800_125_PID, SDP810_125_PID };
+    uint32_t pid;
+    bool alive;
+    if ((snapshot == NULL) || (snapshot->version != SnapshotVersion) ||
+        (snapshot->addr != this->addr) || (snapshot->comp != this->comp) ||
+        (sdp_crc8((const uint8_t *)snapshot, sizeof(SDPSnapshot) - 1) != snapshot->crc)) {
+        return begin();
+    }
+    // A snapshot saved before the sensor was identified, or from a newer layout
+    if (((snapshot->scale != DiffScale_500Pa) && (snapshot->scale != DiffScale_125Pa)) ||
+        (snapshot->number > SDP810_125) || (snapshot->mode > ContinuousAveraging)) {
+        return begin();
+    }
+    this->number = (Model)snapshot->number;
+    this->scale  = snapshot->scale;
+    this->mode   = snapshot->mode;
+    // The sensor may have been swapped for another model at the same address since the
+    // snapshot was saved, so check that it is still the same one
+    if (this->mode == Stopped) {
+        // An idle sensor only answers the product ID request
+        alive = readProductID(&pid, NULL) &&
+                ((pid & 0xFFFFFF00) == ModelPID[this->number]);
+    } else {
+        // A sensor still measuring returns its scale factor after pressure and temperature
+        alive = readData(3) &&
+                ((((uint16_t)this->buffer[4] << 8) | this->buffer[5]) == this->scale);
+    }
+    if (!alive) {
+        return begin();
+    }
+    return (this->scale == DiffScale_500Pa) ? SDP_500 : SDP_125;
+}
+
+/*  Save the state needed to resume after a reset
+
+    @param snapshot - a pointer to store the state
+*/
+void SDPSensor::saveState(SDPSnapshot *snapshot) {
+    snapshot->version  = SnapshotVersion;
+    snapshot->addr     = this->addr;
+    snapshot->number   = this->number;
+    snapshot->comp     = this->comp;
+    snapshot->scale    = this->scale;
+    snapshot->mode     = this->mode;
+    snapshot->reserved = 0;
+    snapshot->crc      = sdp_crc8((const uint8_t *)snapshot, sizeof(SDPSnapshot) - 1);
+}
+
 /*  Begin taking continuous readings
 
     @param averaging - average samples until read occurs, otherwise read last value only
@@ -177,6 +263,9 @@ bool SDPSensor::startContinuous(bool averaging) {
         success = false;
         break;
     }
+    if (success) {
+        this->mode = averaging ? ContinuousAveraging : Continuous;
+    }
     delay(20);
     return success;
 }
@@ -188,13 +277,16 @@ bool SDPSensor::startContinuous(bool averaging) {
 */
 bool SDPSensor::stopContinuous() {
     bool success = writeCommand(StopCont);
+    if (success) {
+        this->mode = Stopped;
+    }
     delay(20);
     return success;
 }
 
 /*  Start a one-shot reading
 
-    @param averaging - average samples until read occurs, otherwise read last value only
+    @param stretching - enable clock stretching
     @returns true, iff everything went correctly
 */
 bool SDPSensor::triggerMeasurement(bool stretching) {
@@ -202,18 +294,33 @@ bool SDPSensor::triggerMeasurement(bool stretching) {
     case MassFlow:
         if (stretching) {
             return writeCommand(TrigMassFlowStretch);
-        } else {
-            return writeCommand(TrigMassFlow);
         }
+        if (!writeCommand(TrigMassFlow)) {
+            return false;
+        }
+        break;
     case DiffPressure:
         if (stretching) {
             return writeCommand(TrigDiffPressureStretch);
-        } else {
-            return writeCommand(TrigDiffPressure);
         }
+        if (!writeCommand(TrigDiffPressure)) {
+            return false;
+        }
+        break;
     default:
         return false;
     }
+    this->triggeredAt = millis();
+    return true;
+}
+
+/*  Check whether a non-stretching triggered measurement has completed
+
+    @returns true, iff TriggerConversionTime has passed since the last trigger
+*/
+bool SDPSensor::measurementReady() {
+    // millis() ticks in whole ms, so wait one more tick to be sure the full time has passed
+    return (millis() - this->triggeredAt) > TriggerConversionTime;
 }
 
 
@@ -318,6 +425,30 @@ bool SDPSensor::readProductID(uint32_t *pid, uint64_t *serial) {
         | Byte  | 0 | 1 | 2 | 3 | 4 | 5 | 6 | 7 | 8 | 9 | 10 | 11 |
         | Value | pid           | serial                          |
     */
+#if defined(__AVR__)
+    /*  8-bit AVR has no barrel shifter, so 64-bit and 32-bit shifts become library calls.
+        It is little endian: store the big endian bytes straight into place instead.
+    */
+    uint8_t *dst;
+    switch (words) {
+    case 6:
+        // "Parse" serial number
+        if (serial != NULL) {
+            dst = (uint8_t *)serial;
+            for (words = 0; words < 8; words++) {
+                dst[7 - words] = this->buffer[words + 4];
+            }
+        }
+    case 2:
+        // "Parse" product identifer
+        if (pid != NULL) {
+            dst = (uint8_t *)pid;
+            for (words = 0; words < 4; words++) {
+                dst[3 - words] = this->buffer[words];
+            }
+        }
+    }
+#else
     switch (words) {
     case 6:
         // "Parse" serial number
@@ -336,6 +467,7 @@ bool SDPSensor::readProductID(uint32_t *pid, uint64_t *serial) {
             }
         }
     }
+#endif
     return true;
 }
 
@@ -350,7 +482,12 @@ bool SDPSensor::reset() {
     this->port->beginTransmission(SoftReset[0]);
     written = this->port->write(SoftReset[1]);
     status  = this->port->endTransmission();
-    return (written == 1) && (status == 0);
+    if ((written == 1) && (status == 0)) {
+        // The sensor comes back idle
+        this->mode = Stopped;
+        return true;
+    }
+    return false;
 }
 
 /*  Get the Pressure Scale for this sensor
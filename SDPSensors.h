@@ -26,6 +26,7 @@
 
 #include "Arduino.h"
 #include <Wire.h>
+#include "SDPCodec.h"
 
 /* Model allows us to specify which digital SDP3x sensor is detected */
 typedef enum {
@@ -92,21 +93,58 @@ const uint8_t DiffScale_500Pa = 60;
 const uint8_t DiffScale_125Pa = 240;
 const uint8_t SDP3X_TempScale = 200;
 
+/* Time a triggered measurement takes, in ms. Reading earlier fails without clock stretching */
+const uint8_t TriggerConversionTime = 45;
+
+/* The longest read in words: product ID and serial number */
+const uint8_t MaxReadWords = 6;
+
+/*  SamplingMode is what the sensor was last told to do
+
+    Stopped             - idle, or taking triggered measurements
+    Continuous          - continuous measurements, last value only
+    ContinuousAveraging - continuous measurements, averaged until read
+*/
+typedef enum { Stopped, Continuous, ContinuousAveraging } SamplingMode;
+
+/* Bump whenever the layout of SDPSnapshot changes */
+const uint8_t SnapshotVersion = 1;
+
+/*  A compact copy of a sensor's state that survives a reset
+
+    Keep it in memory that is not cleared at boot (eg. RTC_NOINIT_ATTR on ESP32, ".noinit" on AVR)
+    or in NVS, so begin() can resume without probing the sensor from scratch.
+*/
+typedef struct {
+    uint8_t version;
+    uint8_t addr;
+    uint8_t number;
+    uint8_t comp;
+    uint8_t scale;
+    uint8_t mode;
+    uint8_t reserved;
+    uint8_t crc;
+} SDPSnapshot;
+
 /* The SDP3x class can be used to interface any SDP sensors */
 class SDPSensor {
     private:
-        /* This sensor instance model number */
-        Model number;
         /* This sensor instance port */
         TwoWire * port = NULL;
-        /* This sensor instance I2C address */
-        uint8_t addr;
+        /* This sensor instance model number */
+        Model number;
         /* The Temperature Compensation mode to use */
         TempCompensation comp;
+        /* This sensor instance I2C address */
+        uint8_t addr;
         /* This sensor instance temperature scale */
         uint8_t scale;
-        /* Internal buffer to reuse for reads */
-        uint8_t buffer[13];
+        /* What the sensor was last told to do */
+        uint8_t mode;
+        /* When the last non-stretching trigger was sent, see measurementReady() */
+        uint32_t triggeredAt;
+        /* Internal buffer to reuse for reads, CRC bytes are not stored */
+        uint8_t buffer[MaxReadWords * 2];
 
         /*  Send a write command
 
@@ -117,7 +155,7 @@ class SDPSensor {
 
         /*  Read data back from the device
 
-            @param words - the number of words to read
+            @param words - the number of words to read, at most MaxReadWords
             @returns true iff all words read and CRC passed
         */
         bool readData(uint8_t words);
@@ -137,6 +175,22 @@ class SDPSensor {
         */
         PressureRange begin();
 
+        /*  Resume from a snapshot taken before a reset
+
+            If the snapshot is valid and belongs to this sensor, a single check confirms the same
+            model still answers: one read of the scale factor when it was measuring, or the
+            product ID when it was idle. Otherwise this falls back to begin().
+            @param snapshot - the state saved by saveState()
+            @returns sensor pressure range, iff everything went correctly or SDP_NA iff not found
+        */
+        PressureRange begin(const SDPSnapshot *snapshot);
+
+        /*  Save the state needed to resume after a reset
+
+            @param snapshot - a pointer to store the state
+        */
+        void saveState(SDPSnapshot *snapshot);
+
         /*  Begin taking continuous readings
 
             @param averaging - average samples until read occurs, otherwise read last value only
@@ -169,6 +223,14 @@ class SDPSensor {
         */
         bool triggerMeasurement(bool stretching);
 
+        /*  Check whether a non-stretching triggered measurement has completed
+
+            Reading right after this turns true avoids holding SCL low for the whole conversion,
+            so the bus stays free for other devices in the meantime.
+            @returns true, iff at least TriggerConversionTime has passed since the last trigger
+        */
+        bool measurementReady();
+
         /*  A handy function to read the differential pressure only.
             Same as readMeasurement(pressure, NULL, NULL).
         */
@@ -215,36 +277,15 @@ class SDPSensor {
         */
         uint8_t getTemperatureScale();
 
-        /*  CRC-8 Lookup Table
-
-            Settings:
-            INIT           - 0xFF
-            POLY           - 0x31
-            Reflect Input  - No
-            Reflect Output - No
-            Final XOR      - 0x00
+        /*  Compute the CRC-8 of a sequence of bytes
 
-            Source: http://www.sunshine2k.de/coding/javascript/crc/crc_js.html
+            The sensor sends this checksum after every 16-bit word. It may be used to check or
+            build raw frames outside of a bus transaction (eg. for a mock bus or a replay log).
+            @param data - the bytes to checksum
+            @param len  - the number of bytes in data
+            @returns the CRC-8 of data
         */
-        const uint8_t CRC_LUT[256] =
-            { 0x00, 0x31, 0x62, 0x53, 0xC4, 0xF5, 0xA6, 0x97, 0xB9, 0x88, 0xDB, 0xEA, 0x7D, 0x4C, 0x1F,
-            0x2E, 0x43, 0x72, 0x21, 0x10, 0x87, 0xB6, 0xE5, 0xD4, 0xFA, 0xCB, 0x98, 0xA9, 0x3E, 0x0F,
-            0x5C, 0x6D, 0x86, 0xB7, 0xE4, 0xD5, 0x42, 0x73, 0x20, 0x11, 0x3F, 0x0E, 0x5D, 0x6C, 0xFB,
-            0xCA, 0x99, 0xA8, 0xC5, 0xF4, 0xA7, 0x96, 0x01, 0x30, 0x63, 0x52, 0x7C, 0x4D, 0x1E, 0x2F,
-            0xB8, 0x89, 0xDA, 0xEB, 0x3D, 0x0C, 0x5F, 0x6E, 0xF9, 0xC8, 0x9B, 0xAA, 0x84, 0xB5, 0xE6,
-            0xD7, 0x40, 0x71, 0x22, 0x13, 0x7E, 0x4F, 0x1C, 0x2D, 0xBA, 0x8B, 0xD8, 0xE9, 0xC7, 0xF6,
-            0xA5, 0x94, 0x03, 0x32, 0x61, 0x50, 0xBB, 0x8A, 0xD9, 0xE8, 0x7F, 0x4E, 0x1D, 0x2C, 0x02,
-            0x33, 0x60, 0x51, 0xC6, 0xF7, 0xA4, 0x95, 0xF8, 0xC9, 0x9A, 0xAB, 0x3C, 0x0D, 0x5E, 0x6F,
-            0x41, 0x70, 0x23, 0x12, 0x85, 0xB4, 0xE7, 0xD6, 0x7A, 0x4B, 0x18, 0x29, 0xBE, 0x8F, 0xDC,
-            0xED, 0xC3, 0xF2, 0xA1, 0x90, 0x07, 0x36, 0x65, 0x54, 0x39, 0x08, 0x5B, 0x6A, 0xFD, 0xCC,
-            0x9F, 0xAE, 0x80, 0xB1, 0xE2, 0xD3, 0x44, 0x75, 0x26, 0x17, 0xFC, 0xCD, 0x9E, 0xAF, 0x38,
-            0x09, 0x5A, 0x6B, 0x45, 0x74, 0x27, 0x16, 0x81, 0xB0, 0xE3, 0xD2, 0xBF, 0x8E, 0xDD, 0xEC,
-            0x7B, 0x4A, 0x19, 0x28, 0x06, 0x37, 0x64, 0x55, 0xC2, 0xF3, 0xA0, 0x91, 0x47, 0x76, 0x25,
-            0x14, 0x83, 0xB2, 0xE1, 0xD0, 0xFE, 0xCF, 0x9C, 0xAD, 0x3A, 0x0B, 0x58, 0x69, 0x04, 0x35,
-            0x66, 0x57, 0xC0, 0xF1, 0xA2, 0x93, 0xBD, 0x8C, 0xDF, 0xEE, 0x79, 0x48, 0x1B, 0x2A, 0xC1,
-            0xF0, 0xA3, 0x92, 0x05, 0x34, 0x67, 0x56, 0x78, 0x49, 0x1A, 0x2B, 0xBC, 0x8D, 0xDE, 0xEF,
-            0x82, 0xB3, 0xE0, 0xD1, 0x46, 0x77, 0x24, 0x15, 0x3B, 0x0A, 0x59, 0x68, 0xFF, 0xCE, 0x9D,
-            0xAC };
+        static uint8_t crc8(const uint8_t *data, uint8_t len);
 };
 
 
@@ -0,0 +1,75 @@
+/*
+    SDPStats.c - Plain C noise statistics of recorded SDP sensor data.
+
+    Copyright (c) 2026 SDP3x-Arduino contributors
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SDPStats.h"
+
+#include <math.h>
+
+/*  Compute the overlapping Allan deviation at one averaging time
+
+    sigma^2(m) = 1 / (2 m^2 (n - 2m + 1)) * sum_j (W(j + m) - W(j))^2
+    where W(j) is the sum of the m samples starting at j. W slides one sample per step and the
+    window sums are kept in integers, so they do not drift over long logs. The squared
+    differences are accumulated in a double.
+
+    @param x - the raw samples, taken at a fixed rate
+    @param n - the number of samples
+    @param m - the averaging time in samples, tau = m * sample period
+    @returns the deviation in raw counts, or 0 iff n < 2 * m + 1
+*/
+double sdp_allan_deviation(const int16_t *x, size_t n, size_t m) {
+    int64_t first = 0, second = 0, diff;
+    double sum = 0;
+    size_t i, j, terms;
+    if ((m == 0) || (n < 2 * m + 1)) {
+        return 0;
+    }
+    terms = n - 2 * m + 1;
+    for (i = 0; i < m; i++) {
+        first += x[i];
+        second += x[i + m];
+    }
+    for (j = 0;; j++) {
+        diff = second - first;
+        sum += (double)diff * (double)diff;
+        if (j + 1 == terms) {
+            break;
+        }
+        first += x[j + m] - x[j];
+        second += x[j + 2 * m] - x[j + m];
+    }
+    return sqrt(sum / (2.0 * (double)m * (double)m * (double)terms));
+}
+
+/*  Compute the overlapping Allan deviation at many averaging times
+
+    @param x     - the raw samples, taken at a fixed rate
+    @param n     - the number of samples
+    @param m     - the averaging times in samples
+    @param count - the number of averaging times
+    @param out   - a buffer of "count" values to store the deviations in raw counts
+*/
+void sdp_allan_deviations(const int16_t *x, size_t n, const size_t *m, size_t count, double *out) {
+    size_t i;
+    for (i = 0; i < count; i++) {
+        out[i] = sdp_allan_deviation(x, n, m[i]);
+    }
+}
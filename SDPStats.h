@@ -0,0 +1,63 @@
+/*
+    SDPStats.h - Plain C noise statistics of recorded SDP sensor data.
+
+    Copyright (c) 2026 SDP3x-Arduino contributors
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+    and associated documentation files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all copies or
+    substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+    BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+    DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef SDPSTATS_H
+#define SDPSTATS_H
+
+/*  Plain C noise statistics of recorded SDP sensor data
+
+    Like SDPCodec.c, this has no Arduino dependency and builds into host tools as is. Functions
+    only read the samples they are given, so they run straight on a memory-mapped log.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*  Compute the overlapping Allan deviation at one averaging time
+
+    The window sums are updated incrementally, so the cost is O(n) whatever "m" is, with no
+    extra memory. Every "m" is independent: to use several threads, give each its own "m" values.
+    @param x - the raw samples, taken at a fixed rate
+    @param n - the number of samples
+    @param m - the averaging time in samples, tau = m * sample period
+    @returns the deviation in raw counts, or 0 iff n < 2 * m + 1
+*/
+double sdp_allan_deviation(const int16_t *x, size_t n, size_t m);
+
+/*  Compute the overlapping Allan deviation at many averaging times
+
+    @param x     - the raw samples, taken at a fixed rate
+    @param n     - the number of samples
+    @param m     - the averaging times in samples
+    @param count - the number of averaging times
+    @param out   - a buffer of "count" values to store the deviations in raw counts
+*/
+void sdp_allan_deviations(const int16_t *x, size_t n, const size_t *m, size_t count, double *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif